@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "AsciiArrayDecoder.hpp"
+#include "AsciiParser.hpp"
+#include "MemoryStreamBuffer.hpp"
+#include "ThreadPool.hpp"
+#include "TokenStore.hpp"
+
+using namespace roff;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+/// Float values formatted like RMS writes zvalues.data: four %.8E values per line.
+//--------------------------------------------------------------------------------------------------
+std::string createFloatArrayText( size_t count )
+{
+    std::string text;
+    char        buffer[32];
+    for ( size_t i = 0; i < count; i++ )
+    {
+        std::snprintf( buffer, sizeof( buffer ), " %16.8E", 1500.0 + 0.37 * static_cast<double>( i ) );
+        text += buffer;
+        if ( i % 4 == 3 ) text += '\n';
+    }
+
+    return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Values in the RMS layout: 6 ints, 4 floats or 4 doubles per line.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+std::string createArrayText( size_t count )
+{
+    if constexpr ( std::is_same_v<T, float> ) return createFloatArrayText( count );
+
+    std::string text;
+    char        buffer[32];
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if constexpr ( std::is_same_v<T, int> )
+        {
+            std::snprintf( buffer, sizeof( buffer ), " %12d", static_cast<int>( i % 100000 ) - 50000 );
+            text += buffer;
+            if ( i % 6 == 5 ) text += '\n';
+        }
+        else
+        {
+            std::snprintf( buffer, sizeof( buffer ), " %24.16E", 1500.0 + 0.37 * static_cast<double>( i ) );
+            text += buffer;
+            if ( i % 4 == 3 ) text += '\n';
+        }
+    }
+
+    return text;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// One std::string and std::stof per value, as AsciiParser used to do.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiFloatArrayStof( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createFloatArrayText( count );
+
+    for ( auto _ : state )
+    {
+        std::vector<float> values;
+        size_t             pos = text.find_first_not_of( " \n" );
+        while ( pos != std::string::npos )
+        {
+            size_t end = text.find_first_of( " \n", pos );
+            values.push_back( std::stof( text.substr( pos, end - pos ) ) );
+            pos = text.find_first_not_of( " \n", end );
+        }
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiFloatArrayStof )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiFloatArrayDecode( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createFloatArrayText( count );
+
+    for ( auto _ : state )
+    {
+        std::vector<float> values( count );
+        AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiFloatArrayDecode )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiFloatArrayDecodeParallel( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createFloatArrayText( count );
+    ThreadPool& pool  = ThreadPool::globalInstance();
+
+    for ( auto _ : state )
+    {
+        std::vector<float> values( count );
+        AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size(), pool );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiFloatArrayDecodeParallel )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//--------------------------------------------------------------------------------------------------
+/// Decoding an array blob through AsciiParser, as Reader does for memory mapped files.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+static void BM_AsciiParserReadArray( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createArrayText<T>( count );
+
+    TokenStore tokens;
+    tokens.push_back( Token( Token::Kind::ARRAYBLOB, 0, text.size() ) );
+
+    MemoryStreamBuffer buffer( text.data(), text.size() );
+    std::istream       stream( &buffer );
+    AsciiParser        parser;
+    std::vector<T>     values( count );
+
+    for ( auto _ : state )
+    {
+        parser.readArray( tokens, stream, 0, static_cast<long>( count ), 0, count, values.data() );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK_TEMPLATE( BM_AsciiParserReadArray, int )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond )->UseRealTime();
+BENCHMARK_TEMPLATE( BM_AsciiParserReadArray, float )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond )->UseRealTime();
+BENCHMARK_TEMPLATE( BM_AsciiParserReadArray, double )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond )->UseRealTime();
@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "AsciiTokenizer.hpp"
+#include "MemoryStreamBuffer.hpp"
+#include "RoffTestDataDirectory.hpp"
+
+using namespace roff;
+
+namespace
+{
+std::string readTestFile( const std::string& fileName )
+{
+    std::ifstream      stream( std::string( TEST_DATA_DIR ) + "/" + fileName, std::ios::binary );
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Float values formatted like RMS writes them: four %.8E values per line.
+//--------------------------------------------------------------------------------------------------
+std::string createFloatValuesText( size_t count )
+{
+    std::string text;
+    char        buffer[32];
+    for ( size_t i = 0; i < count; i++ )
+    {
+        std::snprintf( buffer, sizeof( buffer ), " %16.8E", 1500.0 + 0.37 * static_cast<double>( i ) );
+        text += buffer;
+        if ( i % 4 == 3 ) text += '\n';
+    }
+
+    return text;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// Tokenization of a stream that is not in memory, which is read into memory before it is scanned.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiTokenizeStream( benchmark::State& state )
+{
+    std::string content = readTestFile( "reek_box_grid_w_props.roffasc" );
+
+    for ( auto _ : state )
+    {
+        std::istringstream stream( content );
+        AsciiTokenizer     tokenizer;
+        benchmark::DoNotOptimize( tokenizer.tokenizeStream( stream ) );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( content.size() ) );
+}
+BENCHMARK( BM_AsciiTokenizeStream )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+/// Cursor based tokenization of the same file held in memory.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiTokenizeBuffer( benchmark::State& state )
+{
+    std::string content = readTestFile( "reek_box_grid_w_props.roffasc" );
+
+    for ( auto _ : state )
+    {
+        AsciiTokenizer tokenizer;
+        benchmark::DoNotOptimize( tokenizer.tokenizeBuffer( content.data(), content.size() ) );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( content.size() ) );
+}
+BENCHMARK( BM_AsciiTokenizeBuffer )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+/// Runs of white space separated by single characters.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiTokenizeSpace( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        text += i % 4 == 3 ? "\n   x" : "   x";
+    }
+
+    for ( auto _ : state )
+    {
+        std::istringstream stream( text );
+        AsciiTokenizer     tokenizer;
+        while ( tokenizer.tokenizeSpace( stream ) )
+        {
+            stream.get();
+        }
+        benchmark::DoNotOptimize( stream.tellg() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiTokenizeSpace )->Arg( 1 << 16 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+/// Number tokens one at a time through std::istream.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiTokenizeNumber( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createFloatValuesText( count );
+
+    for ( auto _ : state )
+    {
+        std::istringstream stream( text );
+        AsciiTokenizer     tokenizer;
+        for ( size_t i = 0; i < count; i++ )
+        {
+            benchmark::DoNotOptimize( tokenizer.tokenizeNumber( stream ) );
+        }
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiTokenizeNumber )->Arg( 1 << 16 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+/// The values of a float array, which become a single blob token.
+//--------------------------------------------------------------------------------------------------
+static void BM_AsciiTokenizeArrayData( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text  = createFloatValuesText( count );
+
+    for ( auto _ : state )
+    {
+        MemoryStreamBuffer buffer( text.data(), text.size() );
+        std::istream       stream( &buffer );
+        AsciiTokenizer     tokenizer;
+        benchmark::DoNotOptimize( tokenizer.tokenizeArrayData( stream, count, Token::Kind::FLOAT ) );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_AsciiTokenizeArrayData )->Arg( 1 << 16 )->Arg( 1 << 20 )->Unit( benchmark::kMillisecond );
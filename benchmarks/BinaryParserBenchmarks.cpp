@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <istream>
+#include <vector>
+
+#include "BinaryParser.hpp"
+#include "MemoryStreamBuffer.hpp"
+#include "TokenStore.hpp"
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+/// Reading an array through BinaryParser. The argument selects native (0) or swapped (1) byte order.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+static void BM_BinaryParserReadArray( benchmark::State& state )
+{
+    size_t            count     = static_cast<size_t>( state.range( 0 ) );
+    bool              swapBytes = state.range( 1 ) != 0;
+    std::vector<char> data( count * sizeof( T ) );
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        data[i] = static_cast<char>( i * 31 );
+    }
+
+    TokenStore tokens;
+    tokens.push_back( Token( Token::Kind::ARRAYBLOB, 0, data.size() ) );
+
+    MemoryStreamBuffer buffer( data.data(), data.size() );
+    std::istream       stream( &buffer );
+    BinaryParser       parser( swapBytes );
+    std::vector<T>     values( count );
+
+    for ( auto _ : state )
+    {
+        parser.readArray( tokens, stream, 0, static_cast<long>( count ), 0, count, values.data() );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( data.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK_TEMPLATE( BM_BinaryParserReadArray, int )
+    ->Args( { 1 << 22, 0 } )
+    ->Args( { 1 << 22, 1 } )
+    ->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_BinaryParserReadArray, float )
+    ->Args( { 1 << 22, 0 } )
+    ->Args( { 1 << 22, 1 } )
+    ->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_BinaryParserReadArray, double )
+    ->Args( { 1 << 22, 0 } )
+    ->Args( { 1 << 22, 1 } )
+    ->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_BinaryParserReadArray, char )->Args( { 1 << 22, 0 } )->Unit( benchmark::kMillisecond );
@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "BinaryTokenizer.hpp"
+#include "RoffTestDataDirectory.hpp"
+
+using namespace roff;
+
+namespace
+{
+//==================================================================================================
+/// Gives access to the string scanning used for all names and keywords of binary files.
+//==================================================================================================
+class StringTokenizer : public BinaryTokenizer
+{
+public:
+    using BinaryTokenizer::tokenizeStringInternal;
+};
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// Zero terminated strings, as the names and keywords of binary files.
+//--------------------------------------------------------------------------------------------------
+static void BM_BinaryTokenizeStringInternal( benchmark::State& state )
+{
+    size_t      count = static_cast<size_t>( state.range( 0 ) );
+    std::string text;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        text += "codeValues";
+        text += '\0';
+    }
+
+    for ( auto _ : state )
+    {
+        std::istringstream stream( text );
+        StringTokenizer    tokenizer;
+        for ( size_t i = 0; i < count; i++ )
+        {
+            benchmark::DoNotOptimize( tokenizer.tokenizeStringInternal( stream, false ) );
+        }
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( count ) );
+}
+BENCHMARK( BM_BinaryTokenizeStringInternal )->Arg( 1 << 16 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+static void BM_BinaryTokenizeStream( benchmark::State& state )
+{
+    std::ifstream      fileStream( std::string( TEST_DATA_DIR ) + "/reek_box_grid_w_props.roff", std::ios::binary );
+    std::ostringstream content;
+    content << fileStream.rdbuf();
+    std::string text = content.str();
+
+    for ( auto _ : state )
+    {
+        std::istringstream stream( text );
+        BinaryTokenizer    tokenizer;
+        benchmark::DoNotOptimize( tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_BIN ) );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( text.size() ) );
+}
+BENCHMARK( BM_BinaryTokenizeStream )->Unit( benchmark::kMillisecond );
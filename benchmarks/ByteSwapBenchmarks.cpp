@@ -0,0 +1,67 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+#include "ByteSwap.hpp"
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+/// Copy of the values as the baseline for reading a native byte order array.
+//--------------------------------------------------------------------------------------------------
+static void BM_FloatArrayCopy( benchmark::State& state )
+{
+    size_t             count = static_cast<size_t>( state.range( 0 ) );
+    std::vector<float> source( count, 1.5f );
+    std::vector<float> values( count );
+
+    for ( auto _ : state )
+    {
+        std::memcpy( values.data(), source.data(), count * sizeof( float ) );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() * count * sizeof( float ) ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * count ) );
+}
+BENCHMARK( BM_FloatArrayCopy )->Arg( 1 << 22 )->Unit( benchmark::kMillisecond );
+
+//--------------------------------------------------------------------------------------------------
+/// Copy and byte swap, as for reading an array with the opposite byte order.
+//--------------------------------------------------------------------------------------------------
+static void BM_FloatArrayCopyAndSwap( benchmark::State& state )
+{
+    size_t             count = static_cast<size_t>( state.range( 0 ) );
+    std::vector<float> source( count, 1.5f );
+    std::vector<float> values( count );
+
+    for ( auto _ : state )
+    {
+        std::memcpy( values.data(), source.data(), count * sizeof( float ) );
+        ByteSwap::swap( values.data(), count );
+        benchmark::DoNotOptimize( values.data() );
+    }
+
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() * count * sizeof( float ) ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() * count ) );
+}
+BENCHMARK( BM_FloatArrayCopyAndSwap )->Arg( 1 << 22 )->Unit( benchmark::kMillisecond );
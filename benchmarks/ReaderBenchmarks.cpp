@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "GridGenerator.hpp"
+#include "Reader.hpp"
+
+using namespace roff;
+
+namespace
+{
+struct GridSize
+{
+    const char* name;
+    int         nX;
+    int         nY;
+    int         nZ;
+};
+
+// About 4 thousand, 500 thousand and 6 million cells.
+const GridSize gridSizes[] = { { "small", 20, 20, 10 }, { "medium", 100, 100, 50 }, { "large", 250, 250, 100 } };
+
+struct GridFile
+{
+    std::string fileName;
+    size_t      fileSize;
+    size_t      numValues;
+};
+
+//==================================================================================================
+/// Grid files written by the benchmarks, removed at exit.
+//==================================================================================================
+struct GridFiles
+{
+    ~GridFiles()
+    {
+        std::error_code error;
+        for ( const auto& [key, file] : files )
+        {
+            std::filesystem::remove( file.fileName, error );
+        }
+    }
+
+    std::map<std::pair<size_t, bool>, GridFile> files;
+};
+
+//--------------------------------------------------------------------------------------------------
+/// The grid file of the given size, written to the temporary directory on first use.
+//--------------------------------------------------------------------------------------------------
+const GridFile& gridFile( size_t sizeIndex, bool isBinary )
+{
+    static GridFiles gridFiles;
+    auto&            files = gridFiles.files;
+
+    auto it = files.find( { sizeIndex, isBinary } );
+    if ( it != files.end() ) return it->second;
+
+    const GridSize& size     = gridSizes[sizeIndex];
+    std::string     fileName = ( std::filesystem::temp_directory_path() /
+                             ( std::string( "roffcpp-bench-" ) + size.name + ( isBinary ? ".roff" : ".roffasc" ) ) )
+                               .string();
+
+    // A grid with a porosity and a facies parameter.
+    GridGeneratorOptions options;
+    options.nX = size.nX;
+    options.nY = size.nY;
+    options.nZ = size.nZ;
+    GridGenerator::write( fileName, isBinary ? FileType::ROFF_BIN : FileType::ROFF_ASC, options );
+
+    GridFile file;
+    file.fileName  = fileName;
+    file.fileSize  = static_cast<size_t>( std::filesystem::file_size( fileName ) );
+    file.numValues = 0;
+
+    Reader reader( fileName );
+    reader.parse( ParseMode::HEADER_ONLY );
+    for ( const auto& [name, kind] : reader.getNamedArrayTypes() )
+    {
+        file.numValues += reader.getArrayLength( name );
+    }
+
+    return files.emplace( std::make_pair( sizeIndex, isBinary ), file ).first->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void setCounters( benchmark::State& state, const GridFile& file, size_t numValues )
+{
+    state.SetBytesProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( file.fileSize ) );
+    state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * static_cast<int64_t>( numValues ) );
+    state.SetLabel( gridSizes[state.range( 0 )].name );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// Tokenizing and parsing a grid file. Items are the array values in the file.
+//--------------------------------------------------------------------------------------------------
+template <bool isBinary>
+static void BM_ReaderParse( benchmark::State& state )
+{
+    const GridFile& file = gridFile( static_cast<size_t>( state.range( 0 ) ), isBinary );
+
+    for ( auto _ : state )
+    {
+        Reader reader( file.fileName );
+        reader.parse();
+        benchmark::DoNotOptimize( reader.getNamedArrayTypes().data() );
+    }
+
+    setCounters( state, file, file.numValues );
+}
+BENCHMARK_TEMPLATE( BM_ReaderParse, true )->DenseRange( 0, 2 )->Unit( benchmark::kMillisecond )->UseRealTime();
+BENCHMARK_TEMPLATE( BM_ReaderParse, false )->DenseRange( 0, 2 )->Unit( benchmark::kMillisecond )->UseRealTime();
+
+//--------------------------------------------------------------------------------------------------
+/// Parsing a grid file and reading all its arrays, as when loading a grid with its parameters.
+//--------------------------------------------------------------------------------------------------
+template <bool isBinary>
+static void BM_ReaderParseAndReadArrays( benchmark::State& state )
+{
+    const GridFile& file = gridFile( static_cast<size_t>( state.range( 0 ) ), isBinary );
+
+    for ( auto _ : state )
+    {
+        Reader reader( file.fileName );
+        reader.parse();
+        benchmark::DoNotOptimize( reader.getFloatArray( "cornerLines.data" ).data() );
+        benchmark::DoNotOptimize( reader.getByteArray( "zvalues.splitEnz" ).data() );
+        benchmark::DoNotOptimize( reader.getFloatArray( "zvalues.data" ).data() );
+        benchmark::DoNotOptimize( reader.getByteArray( "active.data" ).data() );
+        benchmark::DoNotOptimize( reader.getFloatArray( "PORO" ).data() );
+        benchmark::DoNotOptimize( reader.getIntArray( "FACIES" ).data() );
+    }
+
+    setCounters( state, file, file.numValues );
+}
+BENCHMARK_TEMPLATE( BM_ReaderParseAndReadArrays, true )
+    ->DenseRange( 0, 2 )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime();
+BENCHMARK_TEMPLATE( BM_ReaderParseAndReadArrays, false )
+    ->DenseRange( 0, 2 )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime();
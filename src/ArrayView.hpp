@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Read-only view of array values. The view either points directly into the memory mapped file
+/// of a Reader (valid as long as the Reader lives), or keeps a copy of the values alive itself.
+//==================================================================================================
+template <typename T>
+class ArrayView
+{
+public:
+    ArrayView()
+        : m_data( nullptr )
+        , m_size( 0 )
+    {
+    }
+
+    ArrayView( const T* data, size_t size )
+        : m_data( data )
+        , m_size( size )
+    {
+    }
+
+    explicit ArrayView( std::shared_ptr<const std::vector<T>> storage )
+        : m_data( storage->data() )
+        , m_size( storage->size() )
+        , m_storage( std::move( storage ) )
+    {
+    }
+
+    const T* data() const { return m_data; }
+    size_t   size() const { return m_size; }
+    bool     empty() const { return m_size == 0; }
+
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    const T& operator[]( size_t index ) const { return m_data[index]; }
+
+    // True if the values are a copy owned by the view instead of a view of the mapped file.
+    bool isCopy() const { return m_storage != nullptr; }
+
+private:
+    const T*                              m_data;
+    size_t                                m_size;
+    std::shared_ptr<const std::vector<T>> m_storage;
+};
+} // namespace roff
@@ -0,0 +1,409 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "AsciiArrayDecoder.hpp"
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+inline bool isSpace( char c )
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Skip white space and #comments#.
+//--------------------------------------------------------------------------------------------------
+const char* skipDelimiters( const char* pos, const char* end )
+{
+    while ( pos != end )
+    {
+        if ( isSpace( *pos ) )
+        {
+            pos++;
+        }
+        else if ( *pos == '#' )
+        {
+            auto commentEnd =
+                static_cast<const char*>( std::memchr( pos + 1, '#', static_cast<size_t>( end - pos - 1 ) ) );
+            if ( !commentEnd ) return end;
+            pos = commentEnd + 1;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const char* findValueEnd( const char* pos, const char* end )
+{
+    while ( pos != end && !isSpace( *pos ) && *pos != '#' )
+        pos++;
+
+    return pos;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+[[noreturn]] void throwInvalidValue( const char* begin, const char* end )
+{
+    throw std::runtime_error( "Invalid numeric value: '" + std::string( begin, end ) + "'" );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Correctly rounded conversion of the complete range [begin, end) to a floating point value.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+T parseFloatingPoint( const char* begin, const char* end )
+{
+    // Neither from_chars nor the RMS format use a leading plus, but accept it anyway.
+    const char* first = ( begin != end && *begin == '+' ) ? begin + 1 : begin;
+
+#if defined( __cpp_lib_to_chars )
+    T    value  = 0;
+    auto result = std::from_chars( first, end, value );
+    if ( result.ec == std::errc::result_out_of_range && result.ptr == end )
+    {
+        // Out of range for T (e.g. below the smallest float): round through double.
+        double wideValue = 0.0;
+        result           = std::from_chars( first, end, wideValue );
+        value            = static_cast<T>( wideValue );
+    }
+
+    if ( result.ec != std::errc() || result.ptr != end ) throwInvalidValue( begin, end );
+    return value;
+#else
+    // Standard libraries without floating point from_chars: fall back to strtod on a terminated copy.
+    char   buffer[64];
+    size_t length = static_cast<size_t>( end - first );
+    if ( length == 0 || length >= sizeof( buffer ) ) throwInvalidValue( begin, end );
+
+    std::memcpy( buffer, first, length );
+    buffer[length] = '\0';
+
+    char*  parsedEnd = nullptr;
+    double value     = std::strtod( buffer, &parsedEnd );
+    if ( parsedEnd != buffer + length ) throwInvalidValue( begin, end );
+    return static_cast<T>( value );
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int parseInteger( const char* begin, const char* end )
+{
+    const char* first = ( begin != end && *begin == '+' ) ? begin + 1 : begin;
+
+    int  value  = 0;
+    auto result = std::from_chars( first, end, value );
+    if ( result.ec == std::errc() && result.ptr == end ) return value;
+    if ( result.ec == std::errc::result_out_of_range ) throwInvalidValue( begin, end );
+
+    // Accept integers written in floating point notation (e.g. 1.0E+00), as long as they are exact ints.
+    double floatingValue = parseFloatingPoint<double>( begin, end );
+    if ( !( floatingValue >= std::numeric_limits<int>::min() && floatingValue <= std::numeric_limits<int>::max() ) ||
+         floatingValue != std::trunc( floatingValue ) )
+    {
+        throwInvalidValue( begin, end );
+    }
+
+    return static_cast<int>( floatingValue );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+char parseByteValue( const char* begin, const char* end )
+{
+    // Byte and bool values are written as integers.
+    int value = parseInteger( begin, end );
+    if ( value < 0 || value > std::numeric_limits<unsigned char>::max() ) throwInvalidValue( begin, end );
+    return static_cast<char>( value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T, typename ParseFunction>
+size_t decodeValues( const char*   begin,
+                     const char*   end,
+                     T*            values,
+                     size_t        count,
+                     ParseFunction parse,
+                     const char**  valuesEnd = nullptr )
+{
+    size_t      numValues = 0;
+    const char* lastEnd   = begin;
+    const char* pos       = skipDelimiters( begin, end );
+    while ( numValues < count && pos != end )
+    {
+        const char* valueEnd = findValueEnd( pos, end );
+        values[numValues++]  = parse( pos, valueEnd );
+        lastEnd              = valueEnd;
+        pos                  = skipDelimiters( valueEnd, end );
+    }
+
+    if ( valuesEnd ) *valuesEnd = lastEnd;
+    return numValues;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Number of white space separated values in [pos, end). Only valid for ranges without comments.
+//--------------------------------------------------------------------------------------------------
+size_t countValues( const char* pos, const char* end )
+{
+    size_t numValues = 0;
+    bool   inValue   = false;
+    for ( ; pos != end; pos++ )
+    {
+        bool space = isSpace( *pos );
+        if ( !space && !inValue ) numValues++;
+        inValue = !space;
+    }
+
+    return numValues;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Splits the range into chunks at white space, counts the values of each chunk to find where its
+/// values go in the output, and then decodes the chunks independently.
+//--------------------------------------------------------------------------------------------------
+template <typename T, typename ParseFunction>
+size_t decodeValuesParallel( const char*   begin,
+                             const char*   end,
+                             T*            values,
+                             size_t        count,
+                             ParseFunction parse,
+                             ThreadPool&   pool,
+                             const char**  valuesEnd )
+{
+    constexpr size_t minChunkSize = 256 * 1024;
+
+    size_t size = static_cast<size_t>( end - begin );
+    if ( pool.size() < 2 || size < 2 * minChunkSize )
+    {
+        return decodeValues( begin, end, values, count, parse, valuesEnd );
+    }
+
+    // Chunk boundaries could end up inside comments, which are very rare in arrays.
+    if ( std::memchr( begin, '#', size ) ) return decodeValues( begin, end, values, count, parse, valuesEnd );
+
+    size_t numChunks = std::min( size / minChunkSize, 4 * pool.size() );
+    size_t chunkSize = size / numChunks;
+
+    std::vector<const char*> boundaries( numChunks + 1, end );
+    boundaries[0] = begin;
+    for ( size_t i = 1; i < numChunks; i++ )
+    {
+        const char* pos = std::max( begin + i * chunkSize, boundaries[i - 1] );
+        while ( pos != end && !isSpace( *pos ) )
+            pos++;
+        boundaries[i] = pos;
+    }
+
+    std::vector<size_t> chunkCounts( numChunks );
+    pool.parallelFor( numChunks,
+                      [&]( size_t i ) { chunkCounts[i] = countValues( boundaries[i], boundaries[i + 1] ); } );
+
+    std::vector<size_t> chunkOffsets( numChunks );
+    size_t              numValues = 0;
+    for ( size_t i = 0; i < numChunks; i++ )
+    {
+        chunkOffsets[i] = std::min( numValues, count );
+        numValues += chunkCounts[i];
+    }
+
+    std::vector<const char*> chunkEnds( boundaries.begin(), boundaries.end() - 1 );
+    pool.parallelFor(
+        numChunks,
+        [&]( size_t i )
+        {
+            size_t chunkCapacity = std::min( chunkCounts[i], count - chunkOffsets[i] );
+            T*     chunkValues   = values + chunkOffsets[i];
+            decodeValues( boundaries[i], boundaries[i + 1], chunkValues, chunkCapacity, parse, &chunkEnds[i] );
+        } );
+
+    // The values end in the last chunk that had values to decode.
+    if ( valuesEnd )
+    {
+        *valuesEnd = begin;
+        for ( size_t i = 0; i < numChunks; i++ )
+        {
+            if ( std::min( chunkCounts[i], count - chunkOffsets[i] ) > 0 ) *valuesEnd = chunkEnds[i];
+        }
+    }
+
+    return std::min( numValues, count );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t
+    AsciiArrayDecoder::decode( const char* begin, const char* end, int* values, size_t count, const char** valuesEnd )
+{
+    return decodeValues( begin, end, values, count, parseInteger, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t
+    AsciiArrayDecoder::decode( const char* begin, const char* end, float* values, size_t count, const char** valuesEnd )
+{
+    return decodeValues( begin, end, values, count, parseFloatingPoint<float>, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t AsciiArrayDecoder::decode( const char*  begin,
+                                  const char*  end,
+                                  double*      values,
+                                  size_t       count,
+                                  const char** valuesEnd )
+{
+    return decodeValues( begin, end, values, count, parseFloatingPoint<double>, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t
+    AsciiArrayDecoder::decode( const char* begin, const char* end, char* values, size_t count, const char** valuesEnd )
+{
+    return decodeValues( begin, end, values, count, parseByteValue, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t AsciiArrayDecoder::decode( const char*  begin,
+                                  const char*  end,
+                                  int*         values,
+                                  size_t       count,
+                                  ThreadPool&  pool,
+                                  const char** valuesEnd )
+{
+    return decodeValuesParallel( begin, end, values, count, parseInteger, pool, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t AsciiArrayDecoder::decode( const char*  begin,
+                                  const char*  end,
+                                  float*       values,
+                                  size_t       count,
+                                  ThreadPool&  pool,
+                                  const char** valuesEnd )
+{
+    return decodeValuesParallel( begin, end, values, count, parseFloatingPoint<float>, pool, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t AsciiArrayDecoder::decode( const char*  begin,
+                                  const char*  end,
+                                  double*      values,
+                                  size_t       count,
+                                  ThreadPool&  pool,
+                                  const char** valuesEnd )
+{
+    return decodeValuesParallel( begin, end, values, count, parseFloatingPoint<double>, pool, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t AsciiArrayDecoder::decode( const char*  begin,
+                                  const char*  end,
+                                  char*        values,
+                                  size_t       count,
+                                  ThreadPool&  pool,
+                                  const char** valuesEnd )
+{
+    return decodeValuesParallel( begin, end, values, count, parseByteValue, pool, valuesEnd );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const char* AsciiArrayDecoder::skip( const char* begin, const char* end, size_t count, size_t* numSkipped )
+{
+    const char* pos = begin;
+    size_t      i   = 0;
+    for ( ; i < count; i++ )
+    {
+        const char* valueBegin = skipDelimiters( pos, end );
+        if ( valueBegin == end ) break;
+
+        pos = findValueEnd( valueBegin, end );
+    }
+
+    if ( numSkipped ) *numSkipped = i;
+    return pos;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int AsciiArrayDecoder::parseInt( const char* begin, const char* end )
+{
+    return parseInteger( begin, end );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+float AsciiArrayDecoder::parseFloat( const char* begin, const char* end )
+{
+    return parseFloatingPoint<float>( begin, end );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+double AsciiArrayDecoder::parseDouble( const char* begin, const char* end )
+{
+    return parseFloatingPoint<double>( begin, end );
+}
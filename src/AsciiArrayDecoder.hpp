@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace roff
+{
+class ThreadPool;
+
+//==================================================================================================
+/// Locale independent decoding of ASCII numbers directly from a character buffer.
+/// Values are separated by white space and/or comments. Invalid numbers throw std::runtime_error.
+//==================================================================================================
+class AsciiArrayDecoder
+{
+public:
+    // Decode up to count values from [begin, end). Returns the number of values decoded. If valuesEnd is
+    // given, it is set to the end of the last decoded value.
+    static size_t
+        decode( const char* begin, const char* end, int* values, size_t count, const char** valuesEnd = nullptr );
+    static size_t
+        decode( const char* begin, const char* end, float* values, size_t count, const char** valuesEnd = nullptr );
+    static size_t
+        decode( const char* begin, const char* end, double* values, size_t count, const char** valuesEnd = nullptr );
+    static size_t
+        decode( const char* begin, const char* end, char* values, size_t count, const char** valuesEnd = nullptr );
+
+    // Same as above, but large ranges are split into chunks at white space which are decoded on the pool.
+    static size_t decode( const char*  begin,
+                          const char*  end,
+                          int*         values,
+                          size_t       count,
+                          ThreadPool&  pool,
+                          const char** valuesEnd = nullptr );
+    static size_t decode( const char*  begin,
+                          const char*  end,
+                          float*       values,
+                          size_t       count,
+                          ThreadPool&  pool,
+                          const char** valuesEnd = nullptr );
+    static size_t decode( const char*  begin,
+                          const char*  end,
+                          double*      values,
+                          size_t       count,
+                          ThreadPool&  pool,
+                          const char** valuesEnd = nullptr );
+    static size_t decode( const char*  begin,
+                          const char*  end,
+                          char*        values,
+                          size_t       count,
+                          ThreadPool&  pool,
+                          const char** valuesEnd = nullptr );
+
+    // Position after the first count values in [begin, end), or after the last value if there are fewer
+    // values. If numSkipped is given, it is set to the number of values skipped.
+    static const char* skip( const char* begin, const char* end, size_t count, size_t* numSkipped = nullptr );
+
+    static int    parseInt( const char* begin, const char* end );
+    static float  parseFloat( const char* begin, const char* end );
+    static double parseDouble( const char* begin, const char* end );
+};
+} // namespace roff
@@ -18,11 +18,15 @@
 
 #include "AsciiParser.hpp"
 
+#include "AsciiArrayDecoder.hpp"
 #include "RoffScalar.hpp"
+#include "ThreadPool.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <stdexcept>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -32,7 +36,7 @@ using namespace roff;
 ///
 //--------------------------------------------------------------------------------------------------
 AsciiParser::AsciiParser()
-    : Parser()
+    : ParserImpl<AsciiParser>()
 {
 }
 
@@ -55,8 +59,9 @@ std::string AsciiParser::parseString( const Token& token, std::istream& stream )
 //--------------------------------------------------------------------------------------------------
 int AsciiParser::parseInt( const Token& token, std::istream& stream ) const
 {
-    std::string res = parseString( token, stream );
-    return std::stoi( res );
+    std::string      buffer;
+    std::string_view text = readBytes( stream, token.start(), token.end(), buffer );
+    return AsciiArrayDecoder::parseInt( text.data(), text.data() + text.size() );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -64,8 +69,9 @@ int AsciiParser::parseInt( const Token& token, std::istream& stream ) const
 //--------------------------------------------------------------------------------------------------
 double AsciiParser::parseDouble( const Token& token, std::istream& stream ) const
 {
-    std::string res = parseString( token, stream );
-    return std::stod( res );
+    std::string      buffer;
+    std::string_view text = readBytes( stream, token.start(), token.end(), buffer );
+    return AsciiArrayDecoder::parseDouble( text.data(), text.data() + text.size() );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -73,8 +79,9 @@ double AsciiParser::parseDouble( const Token& token, std::istream& stream ) cons
 //--------------------------------------------------------------------------------------------------
 float AsciiParser::parseFloat( const Token& token, std::istream& stream ) const
 {
-    std::string res = parseString( token, stream );
-    return std::stof( res );
+    std::string      buffer;
+    std::string_view text = readBytes( stream, token.start(), token.end(), buffer );
+    return AsciiArrayDecoder::parseFloat( text.data(), text.data() + text.size() );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -94,83 +101,184 @@ unsigned char AsciiParser::parseByte( const Token& token, std::istream& stream )
 }
 
 //--------------------------------------------------------------------------------------------------
-///
+/// Decode the text of the values in blocks instead of one token at a time, directly into the
+/// destination. Large blocks are decoded in parallel on the thread pool of the parser.
 //--------------------------------------------------------------------------------------------------
-std::vector<std::string> AsciiParser::parseStringArray( const std::vector<Token>& tokens,
-                                                        std::istream&             stream,
-                                                        long                      startIndex,
-                                                        long                      arrayLength ) const
+template <typename T>
+void AsciiParser::readArrayValues( const TokenStore& tokens,
+                                   std::istream&     stream,
+                                   long              startIndex,
+                                   long              arrayLength,
+                                   size_t            offset,
+                                   size_t            count,
+                                   T*                values ) const
 {
-    std::vector<std::string> values;
-    for ( long i = startIndex; i < startIndex + arrayLength; i++ )
+    if ( offset + count > static_cast<size_t>( std::max( arrayLength, 0L ) ) )
     {
-        values.push_back( parseString( tokens[i], stream ) );
+        throw std::runtime_error( "Array range out of bounds." );
     }
+    if ( count == 0 ) return;
 
-    return values;
-}
+    // Older token lists have one token per value
+    if ( tokens.kind( startIndex ) != Token::Kind::ARRAYBLOB )
+    {
+        std::string      buffer;
+        std::string_view text = readBytes( stream,
+                                           tokens.start( startIndex + offset ),
+                                           tokens.end( startIndex + offset + count - 1 ),
+                                           buffer );
 
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-std::vector<int>
-    AsciiParser::parseIntArray( const std::vector<Token>& tokens, std::istream& stream, long startIndex, long arrayLength ) const
-{
-    std::vector<int> values;
-    for ( long i = startIndex; i < startIndex + arrayLength; i++ )
+        size_t numValues =
+            AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values, count, threadPool() );
+        if ( numValues != count ) throw std::runtime_error( "Unexpected number of array values." );
+        return;
+    }
+
+    // Numeric arrays are a single blob token. The blob is read in blocks from the closest checkpoint
+    // before offset, so the cost of a read depends on count and not on the size of the array.
+    constexpr size_t minBlockSize       = 65536;
+    constexpr size_t maxBlockSize       = 16 * 1024 * 1024;
+    constexpr size_t bytesPerValue      = 32;
+    constexpr size_t checkpointInterval = 65536;
+
+    size_t blobStart            = tokens.start( startIndex );
+    size_t blobEnd              = tokens.end( startIndex );
+    auto [valueIndex, position] = findCheckpoint( blobStart, offset );
+
+    std::string buffer;
+    size_t      numDecoded   = 0;
+    size_t      minBlockRead = 0;
+    while ( numDecoded < count )
     {
-        values.push_back( parseInt( tokens[i], stream ) );
+        size_t blockSize = std::clamp( ( offset + count - valueIndex ) * bytesPerValue, minBlockSize, maxBlockSize );
+        size_t blockEnd  = std::min( position + std::max( blockSize, minBlockRead ), blobEnd );
+
+        std::string_view text  = readBytes( stream, position, blockEnd, buffer );
+        const char*      begin = text.data();
+        const char*      end   = text.data() + text.size();
+
+        // Unless the blob ends in the block, the last value of the block may be incomplete.
+        if ( blockEnd < blobEnd )
+        {
+            size_t lastSpace = text.find_last_of( " \t\n\r\v\f" );
+            end              = begin + ( lastSpace == std::string_view::npos ? 0 : lastSpace );
+        }
+
+        const char* pos = begin;
+        while ( valueIndex < offset )
+        {
+            size_t nextCheckpoint = ( valueIndex / checkpointInterval + 1 ) * checkpointInterval;
+            size_t numToSkip      = std::min( offset, nextCheckpoint ) - valueIndex;
+            size_t numSkipped     = 0;
+
+            pos = AsciiArrayDecoder::skip( pos, end, numToSkip, &numSkipped );
+            valueIndex += numSkipped;
+
+            if ( numSkipped < numToSkip ) break;
+            if ( valueIndex % checkpointInterval == 0 )
+            {
+                addCheckpoint( blobStart, valueIndex, position + static_cast<size_t>( pos - begin ) );
+            }
+        }
+
+        if ( valueIndex == offset + numDecoded )
+        {
+            const char* valuesEnd = pos;
+            size_t      numValues = AsciiArrayDecoder::decode(
+                pos, end, values + numDecoded, count - numDecoded, threadPool(), &valuesEnd );
+            if ( numValues > 0 ) pos = valuesEnd;
+            numDecoded += numValues;
+            valueIndex += numValues;
+        }
+
+        if ( pos == begin )
+        {
+            if ( blockEnd == blobEnd ) throw std::runtime_error( "Unexpected number of array values." );
+
+            // A value or comment larger than the block
+            minBlockRead = 2 * ( blockEnd - position );
+            continue;
+        }
+
+        position += static_cast<size_t>( pos - begin );
     }
 
-    return values;
+    // The next part of the array is often read next
+    addCheckpoint( blobStart, valueIndex, position );
 }
 
+// The readArray overrides of ParserImpl are inline, so they can be instantiated outside this file.
+template void AsciiParser::readArrayValues(
+    const TokenStore&, std::istream&, long, long, size_t, size_t, int* ) const;
+template void AsciiParser::readArrayValues(
+    const TokenStore&, std::istream&, long, long, size_t, size_t, float* ) const;
+template void AsciiParser::readArrayValues(
+    const TokenStore&, std::istream&, long, long, size_t, size_t, double* ) const;
+template void AsciiParser::readArrayValues(
+    const TokenStore&, std::istream&, long, long, size_t, size_t, char* ) const;
+
 //--------------------------------------------------------------------------------------------------
-///
+/// The checkpoint with the largest value index not after valueIndex, as (value index, position).
+/// The start of the blob when there is none.
 //--------------------------------------------------------------------------------------------------
-std::vector<char> AsciiParser::parseByteArray( const std::vector<Token>& tokens,
-                                               std::istream&             stream,
-                                               long                      startIndex,
-                                               long                      arrayLength ) const
+std::pair<size_t, size_t> AsciiParser::findCheckpoint( size_t blobStart, size_t valueIndex ) const
 {
-    std::vector<char> values;
-    for ( long i = startIndex; i < startIndex + arrayLength; i++ )
+    std::lock_guard<std::mutex> lock( m_checkpointMutex );
+
+    auto blob = m_checkpoints.find( blobStart );
+    if ( blob != m_checkpoints.end() )
     {
-        values.push_back( static_cast<char>( parseInt( tokens[i], stream ) ) );
+        auto it = blob->second.upper_bound( valueIndex );
+        if ( it != blob->second.begin() ) return *std::prev( it );
     }
 
-    return values;
+    return std::make_pair( size_t( 0 ), blobStart );
 }
 
 //--------------------------------------------------------------------------------------------------
-///
+/// position is where value valueIndex of the blob starts, or the white space in front of it.
 //--------------------------------------------------------------------------------------------------
-std::vector<float> AsciiParser::parseFloatArray( const std::vector<Token>& tokens,
-                                                 std::istream&             stream,
-                                                 long                      startIndex,
-                                                 long                      arrayLength ) const
+void AsciiParser::addCheckpoint( size_t blobStart, size_t valueIndex, size_t position ) const
 {
-    std::vector<float> values;
-    for ( long i = startIndex; i < startIndex + arrayLength; i++ )
-    {
-        values.push_back( static_cast<float>( parseDouble( tokens[i], stream ) ) );
-    }
-
-    return values;
+    std::lock_guard<std::mutex> lock( m_checkpointMutex );
+    m_checkpoints[blobStart].emplace( valueIndex, position );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<double> AsciiParser::parseDoubleArray( const std::vector<Token>& tokens,
-                                                   std::istream&             stream,
-                                                   long                      startIndex,
-                                                   long                      arrayLength ) const
+std::vector<std::string> AsciiParser::parseStringArray( const TokenStore& tokens,
+                                                        std::istream&     stream,
+                                                        long              startIndex,
+                                                        long              arrayLength ) const
 {
-    std::vector<double> values;
+    std::vector<std::string> values;
+    if ( arrayLength > 0 && tokens.kind( startIndex ) == Token::Kind::ARRAYBLOB )
+    {
+        // All the quoted strings in one token (header only parsing)
+        std::string      buffer;
+        std::string_view text = readBytes( stream, tokens.start( startIndex ), tokens.end( startIndex ), buffer );
+
+        size_t openingQuote = text.find( '"' );
+        while ( openingQuote != std::string_view::npos && values.size() < static_cast<size_t>( arrayLength ) )
+        {
+            size_t closingQuote = text.find( '"', openingQuote + 1 );
+            if ( closingQuote == std::string_view::npos ) break;
+
+            values.emplace_back( text.substr( openingQuote + 1, closingQuote - openingQuote - 1 ) );
+            openingQuote = text.find( '"', closingQuote + 1 );
+        }
+
+        if ( values.size() != static_cast<size_t>( arrayLength ) )
+        {
+            throw std::runtime_error( "Unexpected number of array values." );
+        }
+        return values;
+    }
+
     for ( long i = startIndex; i < startIndex + arrayLength; i++ )
     {
-        values.push_back( parseDouble( tokens[i], stream ) );
+        values.push_back( parseString( tokens[i], stream ) );
     }
 
     return values;
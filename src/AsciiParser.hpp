@@ -19,46 +19,31 @@
 #pragma once
 
 #include "Parser.hpp"
+#include "ParserImpl.hpp"
 #include "Token.hpp"
+#include "TokenStore.hpp"
 
 #include "RoffScalar.hpp"
 
 #include <istream>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
 namespace roff
 {
-class AsciiParser : public Parser
+class AsciiParser final : public ParserImpl<AsciiParser>
 {
 public:
     AsciiParser();
 
-    std::vector<std::string> parseStringArray( const std::vector<Token>& tokens,
-                                               std::istream&             stream,
-                                               long                      startIndex,
-                                               long                      arrayLength ) const override;
-
-    std::vector<int> parseIntArray( const std::vector<Token>& tokens,
-                                    std::istream&             stream,
-                                    long                      startIndex,
-                                    long                      arrayLength ) const override;
-
-    std::vector<double> parseDoubleArray( const std::vector<Token>& tokens,
-                                          std::istream&             stream,
-                                          long                      startIndex,
-                                          long                      arrayLength ) const override;
-
-    std::vector<float> parseFloatArray( const std::vector<Token>& tokens,
-                                        std::istream&             stream,
-                                        long                      startIndex,
-                                        long                      arrayLength ) const override;
-
-    std::vector<char> parseByteArray( const std::vector<Token>& tokens,
-                                      std::istream&             stream,
-                                      long                      startIndex,
-                                      long                      arrayLength ) const override;
+    std::vector<std::string> parseStringArray( const TokenStore& tokens,
+                                               std::istream&     stream,
+                                               long              startIndex,
+                                               long              arrayLength ) const override;
 
     std::string   parseString( const Token& token, std::istream& stream ) const override;
     int           parseInt( const Token& token, std::istream& stream ) const override;
@@ -66,5 +51,26 @@ public:
     float         parseFloat( const Token& token, std::istream& stream ) const override;
     bool          parseBool( const Token& token, std::istream& stream ) const override;
     unsigned char parseByte( const Token& token, std::istream& stream ) const override;
+
+private:
+    friend class ParserImpl<AsciiParser>;
+
+    template <typename T>
+    void readArrayValues( const TokenStore& tokens,
+                          std::istream&     stream,
+                          long              startIndex,
+                          long              arrayLength,
+                          size_t            offset,
+                          size_t            count,
+                          T*                values ) const;
+
+    // Checkpoints are the positions in the stream of values of array blobs, so reading a part of an
+    // array can start close to it instead of at the first value. They are kept by the position of the
+    // blob, so a parser reads the arrays of one stream.
+    std::pair<size_t, size_t> findCheckpoint( size_t blobStart, size_t valueIndex ) const;
+    void                      addCheckpoint( size_t blobStart, size_t valueIndex, size_t position ) const;
+
+    mutable std::unordered_map<size_t, std::map<size_t, size_t>> m_checkpoints;
+    mutable std::mutex                                           m_checkpointMutex;
 };
 } // namespace roff
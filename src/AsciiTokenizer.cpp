@@ -18,18 +18,46 @@
 
 #include "AsciiTokenizer.hpp"
 
+#include "AsciiArrayDecoder.hpp"
+#include "MemoryStreamBuffer.hpp"
+
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <optional>
+#include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 using namespace roff;
 
+namespace
+{
+// Locale independent equivalents of std::isspace and std::isdigit.
+inline bool isSpace( char c )
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+inline bool isDigit( char c )
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isCharValidInNumber( char c )
+{
+    return isDigit( c ) || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+';
+}
+} // namespace
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
 AsciiTokenizer::AsciiTokenizer()
     : Tokenizer()
+    , m_windowSize( 4 * 1024 * 1024 )
 {
 }
 
@@ -197,10 +225,10 @@ std::optional<Token> AsciiTokenizer::tokenizeWord( std::istream& stream, const s
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> AsciiTokenizer::tokenizeTagKeyInternal( std::istream& stream )
+std::vector<Token> AsciiTokenizer::tokenizeTagKeyInternal( std::istream& stream, const Token& typeToken )
 {
     std::vector<Token> tokens;
-    tokens.push_back( tokenizeSimpleType( stream ) );
+    tokens.push_back( typeToken );
     tokens.push_back( tokenizeName( stream ) );
     auto value = tokenizeValue( stream );
     if ( value )
@@ -213,47 +241,527 @@ std::vector<Token> AsciiTokenizer::tokenizeTagKeyInternal( std::istream& stream
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> AsciiTokenizer::tokenizeArrayTagKey( std::istream& stream )
+std::vector<Token> AsciiTokenizer::tokenizeArrayTagKey( std::istream& stream, const Token& arrayToken )
+{
+    std::vector<Token> tokens = tokenizeArrayHeader( stream, arrayToken );
+
+    const Token& numberOfElements = tokens[3];
+
+    auto        streamPos = stream.tellg();
+    std::string numberText( numberOfElements.end() - numberOfElements.start(), '\0' );
+    stream.seekg( numberOfElements.start() );
+    stream.read( numberText.data(), static_cast<std::streamsize>( numberText.size() ) );
+    int numElements = AsciiArrayDecoder::parseInt( numberText.data(), numberText.data() + numberText.size() );
+    stream.seekg( streamPos );
+
+    std::vector<Token> arrayTokens =
+        tokenizeArrayData( stream, static_cast<size_t>( std::max( numElements, 0 ) ), tokens[1].kind() );
+    tokens.insert( tokens.end(), arrayTokens.begin(), arrayTokens.end() );
+
+    return tokens;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The array keyword, type, name and number of elements. The array keyword has already been read,
+/// and the stream is left at the first value.
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> AsciiTokenizer::tokenizeArrayHeader( std::istream& stream, const Token& arrayToken )
 {
     std::vector<Token> tokens;
-    tokens.push_back( tokenizeKeyword( stream, { std::make_pair( Token::Kind::ARRAY, "array" ) } ) );
+    tokens.push_back( arrayToken );
     tokens.push_back( tokenizeSimpleType( stream ) );
     tokens.push_back( tokenizeName( stream ) );
+
     auto numberOfElements = tokenizeNumber( stream );
     if ( !numberOfElements ) throw std::runtime_error( "Expected numeric value" );
 
     tokens.push_back( numberOfElements.value() );
+    return tokens;
+}
 
-    std::vector<Token> arrayTokens = tokenizeArrayData( stream );
-    tokens.insert( tokens.end(), arrayTokens.begin(), arrayTokens.end() );
+//--------------------------------------------------------------------------------------------------
+/// Strings get one token each. Numeric values are kept as one ARRAYBLOB token covering the text of
+/// all the values, and are decoded when the array is read. When parsing headers only, strings are
+/// also kept as one ARRAYBLOB token (including the quotes).
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> AsciiTokenizer::tokenizeArrayData( std::istream& stream, size_t numElements, Token::Kind kind )
+{
+    // Fewer values than expected may just be the end of the window.
+    auto scan = [&]( Cursor& cursor, std::vector<Token>& tokens )
+    { return scanArrayData( cursor, numElements, kind, m_parseMode, tokens ) == numElements; };
 
+    std::vector<Token> tokens;
+    scanStream( stream, tokens, scan, m_windowSize );
     return tokens;
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> AsciiTokenizer::tokenizeArrayData( std::istream& stream )
+std::vector<Token> AsciiTokenizer::tokenizeStream( std::istream& stream )
 {
     std::vector<Token> tokens;
+    scanStream( stream,
+                tokens,
+                [this]( Cursor& cursor, std::vector<Token>& tokens )
+                {
+                    scanFile( cursor, tokens );
+                    return true;
+                },
+                std::numeric_limits<size_t>::max() );
+    return tokens;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Empty if the group is filtered out.
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> AsciiTokenizer::tokenizeTagGroup( std::istream& stream )
+{
+    auto scan = [this]( Cursor& cursor, std::vector<Token>& tokens ) { return scanTagGroup( cursor, tokens ); };
+
+    std::vector<Token> tokens;
+    if ( !scanStream( stream, tokens, scan, m_windowSize ) ) throw std::runtime_error( "Invalid tag group." );
+
+    return tokens;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Tokenize an in-memory roff-asc file, with offsets counted from the start of the stream (offset
+/// bytes before data).
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> AsciiTokenizer::tokenizeBuffer( const char* data, size_t size, size_t offset )
+{
+    Cursor cursor{ data, data + size, data, offset };
+
+    std::vector<Token> tokens;
+    scanFile( cursor, tokens );
+    return tokens;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiTokenizer::setWindowSize( size_t windowSize )
+{
+    m_windowSize = std::max( windowSize, size_t( 1 ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Runs scan on the rest of the stream. Memory streams (e.g. memory mapped files) are scanned in
+/// place. Other streams are read into memory from the current position, windowSize bytes at first.
+/// The scan is only complete within the window if it succeeds and stops before the end of the window,
+/// otherwise it is run again on a window twice as large. Seekable streams are left where the scan
+/// stopped.
+//--------------------------------------------------------------------------------------------------
+bool AsciiTokenizer::scanStream( std::istream&       stream,
+                                 std::vector<Token>& tokens,
+                                 const ScanFunction& scan,
+                                 size_t              windowSize ) const
+{
+    auto start = stream.tellg();
+
+    auto memoryBuffer = dynamic_cast<MemoryStreamBuffer*>( stream.rdbuf() );
+    if ( memoryBuffer && start >= 0 )
+    {
+        size_t      offset = static_cast<size_t>( start );
+        const char* data   = memoryBuffer->data() + ( offset - memoryBuffer->startPosition() );
+        Cursor      cursor{ data, memoryBuffer->data() + memoryBuffer->size(), data, offset };
+
+        bool isScanned = scan( cursor, tokens );
+        stream.seekg( static_cast<std::streamoff>( cursor.position() ), std::ios::beg );
+        return isScanned;
+    }
 
-    bool gotNewToken = true;
-    while ( gotNewToken )
+    std::string buffer;
+    if ( start < 0 )
     {
-        auto token = tokenizeValue( stream );
-        if ( token )
-            tokens.push_back( token.value() );
-        else
-            gotNewToken = false;
+        std::ostringstream content;
+        content << stream.rdbuf();
+        buffer = content.str();
+
+        Cursor cursor{ buffer.data(), buffer.data() + buffer.size(), buffer.data(), 0 };
+        return scan( cursor, tokens );
     }
 
-    return tokens;
+    size_t offset = static_cast<size_t>( start );
+    stream.seekg( 0, std::ios::end );
+    size_t remaining = static_cast<size_t>( stream.tellg() ) - offset;
+
+    size_t numTokens = tokens.size();
+    for ( ;; )
+    {
+        // Only the part of the window not read before is read
+        size_t oldSize = buffer.size();
+        buffer.resize( std::min( windowSize, remaining ) );
+        stream.clear();
+        stream.seekg( static_cast<std::streamoff>( offset + oldSize ), std::ios::beg );
+        stream.read( buffer.data() + oldSize, static_cast<std::streamsize>( buffer.size() - oldSize ) );
+        if ( static_cast<size_t>( stream.gcount() ) != buffer.size() - oldSize )
+        {
+            throw std::runtime_error( "Unexpected end of stream." );
+        }
+
+        Cursor cursor{ buffer.data(), buffer.data() + buffer.size(), buffer.data(), offset };
+        bool   isScanned = scan( cursor, tokens );
+        if ( buffer.size() == remaining || ( isScanned && cursor.pos != cursor.end ) )
+        {
+            stream.clear();
+            stream.seekg( static_cast<std::streamoff>( cursor.position() ), std::ios::beg );
+            return isScanned;
+        }
+
+        tokens.erase( tokens.begin() + static_cast<long>( numTokens ), tokens.end() );
+        windowSize = buffer.size() * 2;
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> AsciiTokenizer::tokenizeStream( std::istream& stream )
+bool AsciiTokenizer::scanSpace( Cursor& cursor ) const
+{
+    if ( cursor.pos == cursor.end || !isSpace( *cursor.pos ) ) return false;
+
+    while ( cursor.pos != cursor.end && isSpace( *cursor.pos ) )
+        cursor.pos++;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool AsciiTokenizer::scanComment( Cursor& cursor ) const
 {
-    return Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC );
+    if ( cursor.pos == cursor.end || *cursor.pos != '#' ) return false;
+
+    auto commentEnd = static_cast<const char*>(
+        std::memchr( cursor.pos + 1, '#', static_cast<size_t>( cursor.end - cursor.pos - 1 ) ) );
+
+    // Unterminated comment
+    if ( !commentEnd ) return false;
+
+    cursor.pos = commentEnd + 1;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiTokenizer::scanDelimiter( Cursor& cursor ) const
+{
+    while ( cursor.pos != cursor.end && ( scanSpace( cursor ) || scanComment( cursor ) ) )
+    {
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanString( Cursor& cursor ) const
+{
+    scanDelimiter( cursor );
+
+    // First part of string should be double-quote
+    if ( cursor.pos == cursor.end || *cursor.pos != '"' ) return {};
+
+    const char* start = cursor.pos + 1;
+    auto        end   = static_cast<const char*>(
+        std::memchr( start, '"', static_cast<size_t>( cursor.end - start ) ) );
+
+    // Reached unexpected end of file.
+    if ( !end ) return {};
+
+    Token token( Token::Kind::STRING_LITERAL,
+                 cursor.offset + static_cast<size_t>( start - cursor.begin ),
+                 cursor.offset + static_cast<size_t>( end - cursor.begin ) );
+    cursor.pos = end + 1;
+    return token;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanName( Cursor& cursor ) const
+{
+    scanDelimiter( cursor );
+
+    size_t start = cursor.position();
+    while ( cursor.pos != cursor.end && !isSpace( *cursor.pos ) )
+        cursor.pos++;
+
+    if ( cursor.position() == start ) return {};
+
+    return Token( Token::Kind::NAME, start, cursor.position() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanNumber( Cursor& cursor ) const
+{
+    scanDelimiter( cursor );
+
+    if ( cursor.pos == cursor.end || !( isDigit( *cursor.pos ) || *cursor.pos == '-' ) ) return {};
+
+    size_t start = cursor.position();
+    while ( cursor.pos != cursor.end && isCharValidInNumber( *cursor.pos ) )
+        cursor.pos++;
+
+    return Token( Token::Kind::NUMERIC_VALUE, start, cursor.position() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanValue( Cursor& cursor ) const
+{
+    auto numberToken = scanNumber( cursor );
+    if ( numberToken )
+        return numberToken;
+    else
+        return scanString( cursor );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reads the next word once and classifies it. The cursor is only moved if the word is a keyword.
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanKeyword( Cursor& cursor ) const
+{
+    scanDelimiter( cursor );
+
+    const char* end = cursor.pos;
+    while ( end != cursor.end && !isSpace( *end ) )
+        end++;
+
+    auto kind = Token::keywordKind( std::string_view( cursor.pos, static_cast<size_t>( end - cursor.pos ) ) );
+    if ( !kind ) return {};
+
+    size_t start = cursor.position();
+    cursor.pos   = end;
+    return Token( kind.value(), start, cursor.position() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanKeyword( Cursor& cursor, Token::Kind expectedKind ) const
+{
+    const char* start = cursor.pos;
+
+    auto token = scanKeyword( cursor );
+    if ( token && token->kind() != expectedKind )
+    {
+        cursor.pos = start;
+        return {};
+    }
+
+    return token;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> AsciiTokenizer::scanSimpleType( Cursor& cursor ) const
+{
+    const char* start = cursor.pos;
+
+    auto token = scanKeyword( cursor );
+    if ( token && !Token::isSimpleType( token->kind() ) )
+    {
+        cursor.pos = start;
+        return {};
+    }
+
+    return token;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool AsciiTokenizer::scanTagKey( Cursor& cursor, std::vector<Token>& tokens ) const
+{
+    const char* start = cursor.pos;
+
+    auto typeToken = scanSimpleType( cursor );
+    if ( !typeToken ) return false;
+
+    auto nameToken = scanName( cursor );
+    if ( !nameToken )
+    {
+        cursor.pos = start;
+        return false;
+    }
+
+    auto valueToken = scanValue( cursor );
+    if ( !valueToken )
+    {
+        cursor.pos = start;
+        return false;
+    }
+
+    tokens.push_back( typeToken.value() );
+    tokens.push_back( nameToken.value() );
+    tokens.push_back( valueToken.value() );
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool AsciiTokenizer::scanArrayTagKey( Cursor& cursor, ParseMode mode, std::vector<Token>& tokens ) const
+{
+    const char* start = cursor.pos;
+
+    auto arrayToken = scanKeyword( cursor, Token::Kind::ARRAY );
+    if ( !arrayToken ) return false;
+
+    auto typeToken             = scanSimpleType( cursor );
+    auto nameToken             = typeToken ? scanName( cursor ) : std::nullopt;
+    auto numberOfElementsToken = nameToken ? scanNumber( cursor ) : std::nullopt;
+    if ( !numberOfElementsToken )
+    {
+        cursor.pos = start;
+        return false;
+    }
+
+    tokens.push_back( arrayToken.value() );
+    tokens.push_back( typeToken.value() );
+    tokens.push_back( nameToken.value() );
+    tokens.push_back( numberOfElementsToken.value() );
+
+    const char* numberBegin = cursor.begin + ( numberOfElementsToken->start() - cursor.offset );
+    const char* numberEnd   = cursor.begin + ( numberOfElementsToken->end() - cursor.offset );
+    int         numElements = AsciiArrayDecoder::parseInt( numberBegin, numberEnd );
+
+    scanArrayData( cursor, static_cast<size_t>( std::max( numElements, 0 ) ), typeToken->kind(), mode, tokens );
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// See tokenizeArrayData. Numeric values are only skipped over, not tokenized one by one. Returns the
+/// number of values scanned.
+//--------------------------------------------------------------------------------------------------
+size_t AsciiTokenizer::scanArrayData( Cursor&             cursor,
+                                    size_t              numElements,
+                                    Token::Kind         kind,
+                                    ParseMode           mode,
+                                    std::vector<Token>& tokens ) const
+{
+    size_t numValues = 0;
+    if ( kind == Token::Kind::CHAR && mode == ParseMode::HEADER_ONLY )
+    {
+        size_t start = cursor.position();
+        size_t end   = start;
+        for ( ; numValues < numElements; numValues++ )
+        {
+            scanDelimiter( cursor );
+            if ( cursor.pos == cursor.end || *cursor.pos != '"' ) break;
+
+            auto closingQuote = static_cast<const char*>(
+                std::memchr( cursor.pos + 1, '"', static_cast<size_t>( cursor.end - cursor.pos - 1 ) ) );
+            if ( !closingQuote ) break;
+
+            if ( numValues == 0 ) start = cursor.position();
+            cursor.pos = closingQuote + 1;
+            end        = cursor.position();
+        }
+
+        tokens.push_back( Token( Token::Kind::ARRAYBLOB, start, end ) );
+        return numValues;
+    }
+    else if ( kind == Token::Kind::CHAR )
+    {
+        for ( ; numValues < numElements; numValues++ )
+        {
+            auto stringToken = scanString( cursor );
+            if ( !stringToken ) break;
+
+            tokens.push_back( stringToken.value() );
+        }
+        return numValues;
+    }
+
+    size_t start = cursor.position();
+    size_t end   = start;
+    for ( ; numValues < numElements; numValues++ )
+    {
+        scanDelimiter( cursor );
+        if ( cursor.pos == cursor.end || !( isDigit( *cursor.pos ) || *cursor.pos == '-' ) ) break;
+
+        if ( numValues == 0 ) start = cursor.position();
+        while ( cursor.pos != cursor.end && isCharValidInNumber( *cursor.pos ) )
+            cursor.pos++;
+        end = cursor.position();
+    }
+
+    // Leave the cursor directly after the last value.
+    cursor.pos = cursor.begin + ( end - cursor.offset );
+    tokens.push_back( Token( Token::Kind::ARRAYBLOB, start, end ) );
+    return numValues;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Appends the tokens of a complete tag group. Nothing is appended if the group is incomplete or is
+/// filtered out (the group is then skipped).
+//--------------------------------------------------------------------------------------------------
+bool AsciiTokenizer::scanTagGroup( Cursor& cursor, std::vector<Token>& tokens ) const
+{
+    size_t numTokens = tokens.size();
+
+    auto tagToken  = scanKeyword( cursor, Token::Kind::TAG );
+    auto nameToken = tagToken ? scanName( cursor ) : std::nullopt;
+    if ( !nameToken ) return false;
+
+    tokens.push_back( tagToken.value() );
+    tokens.push_back( nameToken.value() );
+
+    auto tokenText = [&cursor]( const Token& token )
+    { return std::string( cursor.begin + ( token.start() - cursor.offset ), token.end() - token.start() ); };
+
+    std::optional<bool> isIncluded;
+    ParseMode           mode        = m_parseMode;
+    auto                applyFilter = [&]()
+    {
+        isIncluded = isTagGroupIncluded( tokens, numTokens, tokenText );
+        if ( !isIncluded.value() ) mode = ParseMode::HEADER_ONLY;
+    };
+
+    // Parameters are filtered on their first key (the name of the parameter), other groups on the tag
+    // name. The filter is always applied before any array values are scanned.
+    if ( !m_tagFilter || tokenText( nameToken.value() ) != "parameter" ) applyFilter();
+
+    for ( ;; )
+    {
+        bool isScalar = scanTagKey( cursor, tokens );
+        if ( !isIncluded ) applyFilter();
+        if ( !isScalar && !scanArrayTagKey( cursor, mode, tokens ) ) break;
+    }
+
+    auto endTagToken = scanKeyword( cursor, Token::Kind::ENDTAG );
+    if ( !endTagToken )
+    {
+        tokens.erase( tokens.begin() + static_cast<long>( numTokens ), tokens.end() );
+        return false;
+    }
+
+    tokens.push_back( endTagToken.value() );
+
+    if ( !isIncluded.value() ) tokens.erase( tokens.begin() + static_cast<long>( numTokens ), tokens.end() );
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The file type keyword and all the tag groups that follow it.
+//--------------------------------------------------------------------------------------------------
+void AsciiTokenizer::scanFile( Cursor& cursor, std::vector<Token>& tokens ) const
+{
+    auto fileType = scanKeyword( cursor, Token::Kind::ROFF_ASC );
+    if ( !fileType ) throw std::runtime_error( "No matching keyword." );
+
+    tokens.push_back( fileType.value() );
+    while ( scanTagGroup( cursor, tokens ) )
+    {
+    }
 }
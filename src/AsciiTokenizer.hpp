@@ -21,6 +21,7 @@
 #include "Token.hpp"
 #include "Tokenizer.hpp"
 
+#include <functional>
 #include <istream>
 #include <optional>
 #include <vector>
@@ -33,18 +34,71 @@ public:
     AsciiTokenizer();
     virtual ~AsciiTokenizer();
 
+    // Whole files, tag groups and array values are scanned in memory (see tokenizeBuffer). Memory streams
+    // are scanned in place. Other streams are read in windows which grow while a tag group or an array
+    // does not fit, except by tokenizeStream which reads the rest of the stream at once. The other stream
+    // functions read one token at a time, and are used to read files incrementally (StreamReader).
     std::vector<Token>   tokenizeStream( std::istream& stream ) override;
+    std::vector<Token>   tokenizeTagGroup( std::istream& stream ) override;
     bool                 tokenizeSpace( std::istream& stream ) override;
     std::optional<Token> tokenizeString( std::istream& stream ) override;
     Token                tokenizeName( std::istream& stream ) override;
-    std::vector<Token>   tokenizeArrayTagKey( std::istream& stream ) override;
+    std::vector<Token>   tokenizeArrayTagKey( std::istream& stream, const Token& arrayToken ) override;
+    std::vector<Token>   tokenizeArrayHeader( std::istream& stream, const Token& arrayToken ) override;
     std::optional<Token> tokenizeWord( std::istream& stream, const std::string& keywork, Token::Kind kind ) override;
 
     std::optional<Token> tokenizeNumber( std::istream& stream );
     std::optional<Token> tokenizeValue( std::istream& stream );
-    std::vector<Token>   tokenizeArrayData( std::istream& stream );
+    std::vector<Token>   tokenizeArrayData( std::istream& stream, size_t numElements, Token::Kind kind );
+
+    std::vector<Token> tokenizeBuffer( const char* data, size_t size, size_t offset = 0 );
+
+    // Size of the first window read by tokenizeTagGroup and tokenizeArrayData.
+    void setWindowSize( size_t windowSize );
 
 protected:
-    std::vector<Token> tokenizeTagKeyInternal( std::istream& stream ) override;
+    std::vector<Token> tokenizeTagKeyInternal( std::istream& stream, const Token& typeToken ) override;
+
+private:
+    // Position in an in-memory buffer. Token offsets are relative to the start of the stream,
+    // which is at offset bytes before begin.
+    struct Cursor
+    {
+        const char* begin;
+        const char* end;
+        const char* pos;
+        size_t      offset;
+
+        size_t position() const { return offset + static_cast<size_t>( pos - begin ); }
+    };
+
+    using ScanFunction = std::function<bool( Cursor& cursor, std::vector<Token>& tokens )>;
+
+    bool scanStream( std::istream&       stream,
+                     std::vector<Token>& tokens,
+                     const ScanFunction& scan,
+                     size_t              windowSize ) const;
+
+    bool                 scanSpace( Cursor& cursor ) const;
+    bool                 scanComment( Cursor& cursor ) const;
+    void                 scanDelimiter( Cursor& cursor ) const;
+    std::optional<Token> scanString( Cursor& cursor ) const;
+    std::optional<Token> scanName( Cursor& cursor ) const;
+    std::optional<Token> scanNumber( Cursor& cursor ) const;
+    std::optional<Token> scanValue( Cursor& cursor ) const;
+    std::optional<Token> scanKeyword( Cursor& cursor ) const;
+    std::optional<Token> scanKeyword( Cursor& cursor, Token::Kind expectedKind ) const;
+    std::optional<Token> scanSimpleType( Cursor& cursor ) const;
+    bool                 scanTagKey( Cursor& cursor, std::vector<Token>& tokens ) const;
+    bool                 scanArrayTagKey( Cursor& cursor, ParseMode mode, std::vector<Token>& tokens ) const;
+    size_t               scanArrayData( Cursor&             cursor,
+                                        size_t              numElements,
+                                        Token::Kind         kind,
+                                        ParseMode           mode,
+                                        std::vector<Token>& tokens ) const;
+    bool                 scanTagGroup( Cursor& cursor, std::vector<Token>& tokens ) const;
+    void                 scanFile( Cursor& cursor, std::vector<Token>& tokens ) const;
+
+    size_t m_windowSize;
 };
 } // namespace roff
@@ -0,0 +1,468 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "AsciiWriter.hpp"
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <variant>
+
+using namespace roff;
+
+namespace
+{
+// Values per line and characters per value in the RMS layout. Values are right aligned in fields wide
+// enough to always start with a space.
+template <typename T>
+struct Layout;
+
+template <>
+struct Layout<int>
+{
+    static constexpr size_t valuesPerLine = 6;
+    static constexpr size_t fieldWidth    = 13;
+};
+
+template <>
+struct Layout<float>
+{
+    static constexpr size_t valuesPerLine  = 4;
+    static constexpr size_t fieldWidth     = 17;
+    static constexpr int    precision      = 8;
+    static constexpr int    exactPrecision = 112;
+};
+
+template <>
+struct Layout<double>
+{
+    static constexpr size_t valuesPerLine  = 4;
+    static constexpr size_t fieldWidth     = 25;
+    static constexpr int    precision      = 16;
+    static constexpr int    exactPrecision = 767;
+};
+
+template <>
+struct Layout<char>
+{
+    static constexpr size_t valuesPerLine = 12;
+    static constexpr size_t fieldWidth    = 4;
+};
+
+// Values per formatting chunk. A multiple of all line lengths, so every chunk starts at the same column.
+constexpr size_t chunkSize = 12 * 1024;
+
+// Values formatted before the text is written, which bounds the size of the text buffer.
+constexpr size_t batchSize = 32 * chunkSize;
+
+// Digits formatted after the last written digit, for rounding ties the way RMS does.
+constexpr int guardDigits = 4;
+
+// Width of the integers in scalars and array lengths, which are left aligned.
+constexpr size_t integerWidth = 12;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+char* alignRight( char* field, const char* text, size_t length, size_t width )
+{
+    std::memset( field, ' ', width - length );
+    std::memcpy( field + width - length, text, length );
+    return field + width;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::string alignLeft( std::string text, size_t width )
+{
+    if ( text.size() < width ) text.resize( width, ' ' );
+    return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Writes the field of a value to field and returns the end of the field.
+//--------------------------------------------------------------------------------------------------
+char* formatField( char* field, int value )
+{
+    char text[16];
+    auto result = std::to_chars( text, text + sizeof( text ), value );
+    return alignRight( field, text, static_cast<size_t>( result.ptr - text ), Layout<int>::fieldWidth );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Bytes are written as unsigned values.
+//--------------------------------------------------------------------------------------------------
+char* formatField( char* field, char value )
+{
+    char text[4];
+    auto result = std::to_chars( text, text + sizeof( text ), static_cast<unsigned char>( value ) );
+    return alignRight( field, text, static_cast<size_t>( result.ptr - text ), Layout<char>::fieldWidth );
+}
+
+#if defined( __cpp_lib_to_chars )
+//--------------------------------------------------------------------------------------------------
+/// Correctly rounded digits of the value, which are exact when the precision is large enough.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+size_t formatScientific( char* text, size_t size, T value, int precision )
+{
+    auto result = std::to_chars( text, text + size, value, std::chars_format::scientific, precision );
+    return static_cast<size_t>( result.ptr - text );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Rounds the scientific text of a value formatted with formattedPrecision digits after the point to
+/// precision digits, with ties away from zero. Returns the new length.
+//--------------------------------------------------------------------------------------------------
+size_t roundToPrecision( char* text, size_t length, int formattedPrecision, int precision )
+{
+    char* end      = text + length;
+    char* exponent = std::find( text, end, 'e' );
+    if ( exponent == end ) return length; // inf or nan
+
+    size_t dropped   = static_cast<size_t>( formattedPrecision - precision );
+    char*  digitsEnd = exponent - dropped;
+    bool   roundUp   = *digitsEnd >= '5';
+    std::memmove( digitsEnd, exponent, static_cast<size_t>( end - exponent ) );
+    exponent = digitsEnd;
+    end -= dropped;
+
+    if ( !roundUp ) return static_cast<size_t>( end - text );
+
+    for ( char* digit = exponent - 1;; digit-- )
+    {
+        if ( *digit == '.' ) continue;
+        if ( *digit != '9' )
+        {
+            ( *digit )++;
+            return static_cast<size_t>( end - text );
+        }
+
+        *digit = '0';
+        if ( digit == text || digit[-1] == '-' )
+        {
+            // All digits were 9: 9.99E+05 becomes 1.00E+06.
+            *digit = '1';
+            break;
+        }
+    }
+
+    int exponentValue = 0;
+    std::from_chars( exponent + 2, end, exponentValue );
+    if ( exponent[1] == '-' ) exponentValue = -exponentValue;
+    exponentValue++;
+
+    char* pos = exponent + 1;
+    *pos++    = exponentValue < 0 ? '-' : '+';
+    if ( std::abs( exponentValue ) < 10 ) *pos++ = '0';
+    pos = std::to_chars( pos, pos + 4, std::abs( exponentValue ) ).ptr;
+    return static_cast<size_t>( pos - text );
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/// Scientific notation with an upper case exponent, as the %.8E (float) and %.16E (double) formats.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+char* formatFloatingPointField( char* field, T value )
+{
+#if defined( __cpp_lib_to_chars )
+    // RMS rounds ties away from zero, while to_chars rounds them to even. Format a few guard digits and
+    // round here instead. The exact digits are only needed when the guard digits are ambiguous.
+    constexpr int formattedPrecision = Layout<T>::precision + guardDigits;
+
+    char   text[Layout<T>::exactPrecision + 16];
+    size_t length   = formatScientific( text, sizeof( text ), value, formattedPrecision );
+    char*  exponent = std::find( text, text + length, 'e' );
+    if ( exponent != text + length && std::string_view( exponent - guardDigits, guardDigits ) == "5000" )
+    {
+        length = formatScientific( text, sizeof( text ), value, Layout<T>::exactPrecision );
+        length = roundToPrecision( text, length, Layout<T>::exactPrecision, Layout<T>::precision );
+    }
+    else
+    {
+        length = roundToPrecision( text, length, formattedPrecision, Layout<T>::precision );
+    }
+#else
+    // Standard libraries without floating point to_chars: fall back to snprintf.
+    char   text[32];
+    size_t length = static_cast<size_t>(
+        std::snprintf( text, sizeof( text ), "%.*E", Layout<T>::precision, static_cast<double>( value ) ) );
+#endif
+
+    // Also upper cases inf and nan.
+    for ( size_t i = 0; i < length; i++ )
+    {
+        if ( text[i] >= 'a' && text[i] <= 'z' ) text[i] = static_cast<char>( text[i] - 'a' + 'A' );
+    }
+
+    return alignRight( field, text, length, Layout<T>::fieldWidth );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+char* formatField( char* field, float value )
+{
+    return formatFloatingPointField( field, value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+char* formatField( char* field, double value )
+{
+    return formatFloatingPointField( field, value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+std::string formatField( T value )
+{
+    char field[Layout<T>::fieldWidth];
+    return std::string( field, formatField( field, value ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Position of value number index in the text of values where the first value is at the given column.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+size_t textOffset( size_t column, size_t index )
+{
+    return index * Layout<T>::fieldWidth + ( column + index ) / Layout<T>::valuesPerLine;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Writes the fields of the values to text, and ends each line.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void formatValues( const T* values, size_t count, size_t column, char* text )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        text = formatField( text, values[i] );
+        if ( ++column == Layout<T>::valuesPerLine )
+        {
+            *text++ = '\n';
+            column  = 0;
+        }
+    }
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+AsciiWriter::AsciiWriter( std::ostream& stream )
+    : Writer( stream )
+    , m_threadPool( &ThreadPool::globalInstance() )
+    , m_column( 0 )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::setThreadPool( ThreadPool& pool )
+{
+    m_threadPool = &pool;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeFileType()
+{
+    writeLine( Token::kindToString( Token::Kind::ROFF_ASC ) + " " );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeComment( const std::string& comment )
+{
+    writeLine( "#" + comment + "#" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeTagBegin( const std::string& tagName )
+{
+    writeLine( Token::kindToString( Token::Kind::TAG ) + " " + tagName + " " );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeTagEnd()
+{
+    writeLine( Token::kindToString( Token::Kind::ENDTAG ) + " " );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeScalarValue( Token::Kind kind, const std::string& name, const RoffScalar& value )
+{
+    std::string text = Token::kindToString( kind ) + " " + name;
+
+    switch ( kind )
+    {
+        case Token::Kind::INT:
+            text += " " + alignLeft( std::to_string( std::get<int>( value ) ), integerWidth );
+            break;
+        case Token::Kind::FLOAT:
+            text += formatField( std::get<float>( value ) );
+            break;
+        case Token::Kind::DOUBLE:
+            text += formatField( std::get<double>( value ) );
+            break;
+        case Token::Kind::BYTE:
+            text += " " + std::to_string( static_cast<unsigned>( std::get<unsigned char>( value ) ) );
+            break;
+        case Token::Kind::BOOL:
+            text += std::get<bool>( value ) ? " 1" : " 0";
+            break;
+        default:
+            text += "  \"" + std::get<std::string>( value ) + "\"";
+            break;
+    }
+
+    writeLine( text );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayBegin( Token::Kind kind, const std::string& name, size_t length )
+{
+    writeLine( Token::kindToString( Token::Kind::ARRAY ) + " " + Token::kindToString( kind ) + " " + name + " " +
+               alignLeft( std::to_string( length ), integerWidth ) );
+    m_column = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayValues( const int* values, size_t count )
+{
+    writeNumbers( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayValues( const float* values, size_t count )
+{
+    writeNumbers( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayValues( const double* values, size_t count )
+{
+    writeNumbers( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayValues( const char* values, size_t count )
+{
+    writeNumbers( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayValues( const std::string* values, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        writeLine( " \"" + values[i] + "\"" );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Ends the last line when it is not full.
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeArrayEnd()
+{
+    if ( m_column != 0 ) m_stream.put( '\n' );
+    m_column = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void AsciiWriter::writeLine( const std::string& text )
+{
+    m_stream.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+    m_stream.put( '\n' );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The fields have a fixed width, so the position of every value in the text is known up front. The
+/// chunks of a batch are formatted in place in the shared buffer, in parallel when there are several,
+/// and the batch is written in one call. Appended values continue the last line of the previous call.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AsciiWriter::writeNumbers( const T* values, size_t count )
+{
+    while ( count > 0 )
+    {
+        size_t batchCount = std::min( count, batchSize );
+        size_t column     = m_column;
+        m_buffer.resize( textOffset<T>( column, batchCount ) );
+
+        char*  text      = m_buffer.data();
+        size_t numChunks = ( batchCount + chunkSize - 1 ) / chunkSize;
+
+        auto formatChunk = [&]( size_t chunk )
+        {
+            size_t first = chunk * chunkSize;
+            size_t last  = std::min( first + chunkSize, batchCount );
+            formatValues( values + first, last - first, column, text + textOffset<T>( column, first ) );
+        };
+
+        if ( numChunks > 1 )
+        {
+            m_threadPool->parallelFor( numChunks, formatChunk );
+        }
+        else
+        {
+            formatChunk( 0 );
+        }
+
+        m_stream.write( m_buffer.data(), static_cast<std::streamsize>( m_buffer.size() ) );
+
+        m_column = ( column + batchCount ) % Layout<T>::valuesPerLine;
+        values += batchCount;
+        count -= batchCount;
+    }
+}
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+#include "Writer.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace roff
+{
+class ThreadPool;
+
+//==================================================================================================
+/// Writes ASCII ROFF files (roff-asc) in the column layout used by RMS: 4 floats or doubles, 6 ints or
+/// 12 bytes per line, and one string per line. Numbers are formatted locale independently, and large
+/// arrays are formatted in parallel chunks before being written in order.
+//==================================================================================================
+class AsciiWriter : public Writer
+{
+public:
+    explicit AsciiWriter( std::ostream& stream );
+
+    // Pool used for formatting large arrays, the global pool by default.
+    void setThreadPool( ThreadPool& pool );
+
+protected:
+    void writeFileType() override;
+    void writeComment( const std::string& comment ) override;
+    void writeTagBegin( const std::string& tagName ) override;
+    void writeTagEnd() override;
+    void writeScalarValue( Token::Kind kind, const std::string& name, const RoffScalar& value ) override;
+    void writeArrayBegin( Token::Kind kind, const std::string& name, size_t length ) override;
+    void writeArrayValues( const int* values, size_t count ) override;
+    void writeArrayValues( const float* values, size_t count ) override;
+    void writeArrayValues( const double* values, size_t count ) override;
+    void writeArrayValues( const char* values, size_t count ) override;
+    void writeArrayValues( const std::string* values, size_t count ) override;
+    void writeArrayEnd() override;
+
+private:
+    void writeLine( const std::string& text );
+
+    template <typename T>
+    void writeNumbers( const T* values, size_t count );
+
+    ThreadPool* m_threadPool;
+    std::string m_buffer;
+    size_t      m_column;
+};
+} // namespace roff
@@ -23,6 +23,7 @@
 #include <cassert>
 #include <cctype>
 #include <stdexcept>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -31,8 +32,9 @@ using namespace roff;
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-BinaryParser::BinaryParser()
-    : Parser()
+BinaryParser::BinaryParser( bool swapBytes )
+    : ParserImpl<BinaryParser>()
+    , m_swapBytes( swapBytes )
 {
 }
 
@@ -55,7 +57,7 @@ std::string BinaryParser::parseString( const Token& token, std::istream& stream
 //--------------------------------------------------------------------------------------------------
 int BinaryParser::parseInt( const Token& token, std::istream& stream ) const
 {
-    return parseScalar<int, Token::Kind::INT>( token, stream );
+    return readValue<int>( token, stream );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -63,7 +65,7 @@ int BinaryParser::parseInt( const Token& token, std::istream& stream ) const
 //--------------------------------------------------------------------------------------------------
 double BinaryParser::parseDouble( const Token& token, std::istream& stream ) const
 {
-    return parseScalar<double, Token::Kind::DOUBLE>( token, stream );
+    return readValue<double>( token, stream );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -71,7 +73,7 @@ double BinaryParser::parseDouble( const Token& token, std::istream& stream ) con
 //--------------------------------------------------------------------------------------------------
 float BinaryParser::parseFloat( const Token& token, std::istream& stream ) const
 {
-    return parseScalar<float, Token::Kind::FLOAT>( token, stream );
+    return readValue<float>( token, stream );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -79,7 +81,7 @@ float BinaryParser::parseFloat( const Token& token, std::istream& stream ) const
 //--------------------------------------------------------------------------------------------------
 bool BinaryParser::parseBool( const Token& token, std::istream& stream ) const
 {
-    return static_cast<bool>( parseInt( token, stream ) );
+    return static_cast<bool>( readValue<unsigned char>( token, stream ) );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -87,19 +89,42 @@ bool BinaryParser::parseBool( const Token& token, std::istream& stream ) const
 //--------------------------------------------------------------------------------------------------
 unsigned char BinaryParser::parseByte( const Token& token, std::istream& stream ) const
 {
-    return static_cast<unsigned char>( parseInt( token, stream ) );
+    return readValue<unsigned char>( token, stream );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<std::string> BinaryParser::parseStringArray( const std::vector<Token>& tokens,
-                                                         std::istream&             stream,
-                                                         long                      startIndex,
-                                                         long                      arrayLength ) const
+std::vector<std::string> BinaryParser::parseStringArray( const TokenStore& tokens,
+                                                         std::istream&     stream,
+                                                         long              startIndex,
+                                                         long              arrayLength ) const
 {
     stream.clear();
     std::vector<std::string> values;
+    if ( arrayLength > 0 && tokens.kind( startIndex ) == Token::Kind::ARRAYBLOB )
+    {
+        // All the zero terminated strings in one token (header only parsing)
+        std::string      buffer;
+        std::string_view text = readBytes( stream, tokens.start( startIndex ), tokens.end( startIndex ), buffer );
+
+        size_t start = 0;
+        while ( start < text.size() && values.size() < static_cast<size_t>( arrayLength ) )
+        {
+            size_t end = text.find( '\0', start );
+            if ( end == std::string_view::npos ) break;
+
+            values.emplace_back( text.substr( start, end - start ) );
+            start = end + 1;
+        }
+
+        if ( values.size() != static_cast<size_t>( arrayLength ) )
+        {
+            throw std::runtime_error( "Unexpected number of array values." );
+        }
+        return values;
+    }
+
     for ( long i = startIndex; i < startIndex + arrayLength; i++ )
     {
         values.push_back( parseString( tokens[i], stream ) );
@@ -107,47 +132,3 @@ std::vector<std::string> BinaryParser::parseStringArray( const std::vector<Token
 
     return values;
 }
-
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-std::vector<int> BinaryParser::parseIntArray( const std::vector<Token>& tokens,
-                                              std::istream&             stream,
-                                              long                      startIndex,
-                                              long                      arrayLength ) const
-{
-    return parseArray<int, Token::Kind::INT>( tokens, stream, startIndex, arrayLength );
-}
-
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-std::vector<char> BinaryParser::parseByteArray( const std::vector<Token>& tokens,
-                                                std::istream&             stream,
-                                                long                      startIndex,
-                                                long                      arrayLength ) const
-{
-    return parseArray<char, Token::Kind::BYTE>( tokens, stream, startIndex, arrayLength );
-}
-
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-std::vector<float> BinaryParser::parseFloatArray( const std::vector<Token>& tokens,
-                                                  std::istream&             stream,
-                                                  long                      startIndex,
-                                                  long                      arrayLength ) const
-{
-    return parseArray<float, Token::Kind::FLOAT>( tokens, stream, startIndex, arrayLength );
-}
-
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-std::vector<double> BinaryParser::parseDoubleArray( const std::vector<Token>& tokens,
-                                                    std::istream&             stream,
-                                                    long                      startIndex,
-                                                    long                      arrayLength ) const
-{
-    return parseArray<double, Token::Kind::DOUBLE>( tokens, stream, startIndex, arrayLength );
-}
@@ -18,47 +18,33 @@
 
 #pragma once
 
+#include "ByteSwap.hpp"
 #include "Parser.hpp"
+#include "ParserImpl.hpp"
 #include "Token.hpp"
+#include "TokenStore.hpp"
 
 #include "RoffScalar.hpp"
 
+#include <algorithm>
 #include <istream>
 #include <map>
+#include <stdexcept>
 #include <variant>
 #include <vector>
 
 namespace roff
 {
-class BinaryParser : public Parser
+class BinaryParser final : public ParserImpl<BinaryParser>
 {
 public:
-    BinaryParser();
+    // Values are byte swapped when the file has the opposite byte order (see BinaryTokenizer::swapBytes).
+    explicit BinaryParser( bool swapBytes = false );
 
-    std::vector<std::string> parseStringArray( const std::vector<Token>& tokens,
-                                               std::istream&             stream,
-                                               long                      startIndex,
-                                               long                      arrayLength ) const override;
-
-    std::vector<int> parseIntArray( const std::vector<Token>& tokens,
-                                    std::istream&             stream,
-                                    long                      startIndex,
-                                    long                      arrayLength ) const override;
-
-    std::vector<double> parseDoubleArray( const std::vector<Token>& tokens,
-                                          std::istream&             stream,
-                                          long                      startIndex,
-                                          long                      arrayLength ) const override;
-
-    std::vector<float> parseFloatArray( const std::vector<Token>& tokens,
-                                        std::istream&             stream,
-                                        long                      startIndex,
-                                        long                      arrayLength ) const override;
-
-    std::vector<char> parseByteArray( const std::vector<Token>& tokens,
-                                      std::istream&             stream,
-                                      long                      startIndex,
-                                      long                      arrayLength ) const override;
+    std::vector<std::string> parseStringArray( const TokenStore& tokens,
+                                               std::istream&     stream,
+                                               long              startIndex,
+                                               long              arrayLength ) const override;
 
     std::string   parseString( const Token& token, std::istream& stream ) const override;
     int           parseInt( const Token& token, std::istream& stream ) const override;
@@ -68,28 +54,51 @@ public:
     unsigned char parseByte( const Token& token, std::istream& stream ) const override;
 
 private:
-    template <typename T, Token::Kind K>
-    T parseScalar( const Token& token, std::istream& stream ) const
+    friend class ParserImpl<BinaryParser>;
+
+    template <typename T>
+    T readValue( const Token& token, std::istream& stream ) const
     {
         stream.clear();
-        int  length = Token::binaryTokenSizeInBytes( K );
-        auto start  = token.start();
-        T    value;
-        stream.seekg( start );
-        stream.read( reinterpret_cast<char*>( &value ), length );
+        T value;
+        stream.seekg( token.start() );
+        stream.read( reinterpret_cast<char*>( &value ), sizeof( T ) );
+        if constexpr ( sizeof( T ) > 1 )
+        {
+            if ( m_swapBytes ) value = ByteSwap::swapped( value );
+        }
         return value;
     }
 
-    template <typename T, Token::Kind K>
-    std::vector<T> parseArray( const std::vector<Token>& tokens, std::istream& stream, long startIndex, long arrayLength ) const
+    // Reads the values straight from the stream into the destination.
+    template <typename T>
+    void readArrayValues( const TokenStore& tokens,
+                          std::istream&     stream,
+                          long              startIndex,
+                          long              arrayLength,
+                          size_t            offset,
+                          size_t            count,
+                          T*                values ) const
     {
+        if ( offset + count > static_cast<size_t>( std::max( arrayLength, 0L ) ) )
+        {
+            throw std::runtime_error( "Array range out of bounds." );
+        }
+        if ( count == 0 ) return;
+
         stream.clear();
-        std::vector<T> values( arrayLength );
-        int            length = Token::binaryTokenSizeInBytes( K );
-        auto           start  = tokens[startIndex].start();
+        size_t length = sizeof( T );
+        auto   start  = tokens.start( startIndex ) + offset * length;
         stream.seekg( start );
-        stream.read( reinterpret_cast<char*>( values.data() ), static_cast<std::streamsize>( arrayLength ) * length );
-        return values;
+        stream.read( reinterpret_cast<char*>( values ), static_cast<std::streamsize>( count * length ) );
+        if ( static_cast<size_t>( stream.gcount() ) != count * length )
+        {
+            throw std::runtime_error( "Unexpected end of stream." );
+        }
+
+        if ( m_swapBytes ) ByteSwap::swap( values, count );
     }
+
+    bool m_swapBytes;
 };
 } // namespace roff
@@ -18,10 +18,14 @@
 
 #include "BinaryTokenizer.hpp"
 
+#include "ByteSwap.hpp"
+
 #include <cassert>
 #include <cctype>
+#include <limits>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 using namespace roff;
@@ -31,6 +35,7 @@ using namespace roff;
 //--------------------------------------------------------------------------------------------------
 BinaryTokenizer::BinaryTokenizer()
     : Tokenizer()
+    , m_swapBytes( false )
 {
 }
 
@@ -135,33 +140,26 @@ std::optional<Token> BinaryTokenizer::tokenizeWord( std::istream& stream, const
     tokenizeDelimiter( stream );
     auto start = stream.tellg();
 
-    int length = static_cast<int>( keyword.size() );
-
-    std::vector<char> buffer( length );
-    stream.read( &buffer[0], length );
-
-    std::string word( buffer.begin(), buffer.end() );
-
-    if ( stream && keyword.compare( word ) == 0 )
-    {
-        auto end = static_cast<size_t>( start ) + keyword.length();
-        return Token( kind, start, end );
-    }
-    else
+    for ( char expected : keyword )
     {
-        stream.clear();
-        stream.seekg( start );
-        return {};
+        if ( stream.get() != std::char_traits<char>::to_int_type( expected ) )
+        {
+            stream.clear();
+            stream.seekg( start );
+            return {};
+        }
     }
+
+    auto end = static_cast<size_t>( start ) + keyword.length();
+    return Token( kind, start, end );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> BinaryTokenizer::tokenizeTagKeyInternal( std::istream& stream )
+std::vector<Token> BinaryTokenizer::tokenizeTagKeyInternal( std::istream& stream, const Token& typeToken )
 {
     std::vector<Token> tokens;
-    Token              typeToken = tokenizeSimpleType( stream );
     tokens.push_back( typeToken );
 
     tokens.push_back( tokenizeName( stream ) );
@@ -176,39 +174,90 @@ std::vector<Token> BinaryTokenizer::tokenizeTagKeyInternal( std::istream& stream
 }
 
 //--------------------------------------------------------------------------------------------------
-///
+/// The byte order only comes from the filedata tag. It is set once the tag group has been read,
+/// before any array lengths of the following groups are read.
 //--------------------------------------------------------------------------------------------------
-std::vector<Token> BinaryTokenizer::tokenizeArrayTagKey( std::istream& stream )
+std::vector<Token> BinaryTokenizer::tokenizeTagGroup( std::istream& stream )
 {
-    std::vector<Token> tokens;
-    tokens.push_back( tokenizeKeyword( stream, { std::make_pair( Token::Kind::ARRAY, "array" ) } ) );
+    std::vector<Token> tokens = Tokenizer::tokenizeTagGroup( stream );
 
-    auto typeToken = tokenizeSimpleType( stream );
-    tokens.push_back( typeToken );
-    tokens.push_back( tokenizeName( stream ) );
+    const std::string tagName = "filedata";
+    if ( tokens.size() < 2 || tokens[1].end() - tokens[1].start() != tagName.size() ) return tokens;
 
-    auto numElementsToken = tokenizeNumber( stream, Token::Kind::INT );
-    if ( !numElementsToken )
+    auto        streamPos = stream.tellg();
+    std::string name( tagName.size(), '\0' );
+    stream.seekg( tokens[1].start() );
+    stream.read( name.data(), static_cast<std::streamsize>( name.size() ) );
+    stream.seekg( streamPos );
+    if ( name != tagName ) return tokens;
+
+    // The filedata tag only has scalar keys: type, name and value.
+    for ( size_t i = 2; i + 2 < tokens.size() && Token::isSimpleType( tokens[i].kind() ); i += 3 )
     {
-        throw std::runtime_error( "Expected numeric value" );
+        if ( tokens[i].kind() == Token::Kind::INT ) detectByteOrder( tokens[i + 1], tokens[i + 2], stream );
     }
-    tokens.push_back( numElementsToken.value() );
 
-    auto parseInt = []( const Token& token, std::istream& stream )
+    return tokens;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The byteswaptest value is 1 written in the byte order of the file.
+//--------------------------------------------------------------------------------------------------
+void BinaryTokenizer::detectByteOrder( const Token& nameToken, const Token& valueToken, std::istream& stream )
+{
+    const std::string keyword = "byteswaptest";
+
+    if ( nameToken.end() - nameToken.start() != keyword.size() ) return;
+
+    auto        streamPos = stream.tellg();
+    std::string name( keyword.size(), '\0' );
+    stream.seekg( nameToken.start() );
+    stream.read( name.data(), static_cast<std::streamsize>( name.size() ) );
+
+    if ( name == keyword )
     {
-        int length = Token::binaryTokenSizeInBytes( Token::Kind::INT );
+        m_swapBytes = false;
 
-        auto start = token.start();
+        int value = readInt( valueToken, stream );
+        if ( value != 1 && ByteSwap::swapped( value ) != 1 ) throw std::runtime_error( "Unexpected endianness." );
+        m_swapBytes = value != 1;
+    }
 
-        int myint;
-        stream.seekg( start );
-        stream.read( reinterpret_cast<char*>( &myint ), length );
+    stream.clear();
+    stream.seekg( streamPos );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool BinaryTokenizer::swapBytes() const
+{
+    return m_swapBytes;
+}
 
-        return myint;
-    };
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int BinaryTokenizer::readInt( const Token& token, std::istream& stream ) const
+{
+    int value = 0;
+    stream.seekg( token.start() );
+    stream.read( reinterpret_cast<char*>( &value ), sizeof( value ) );
+    return m_swapBytes ? ByteSwap::swapped( value ) : value;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> BinaryTokenizer::tokenizeArrayTagKey( std::istream& stream, const Token& arrayToken )
+{
+    std::vector<Token> tokens = tokenizeArrayHeader( stream, arrayToken );
+
+    const Token& typeToken        = tokens[1];
+    const Token& numElementsToken = tokens[3];
 
     auto streamPos   = stream.tellg();
-    int  numElements = parseInt( numElementsToken.value(), stream );
+    int  numElements = readInt( numElementsToken, stream );
     stream.seekg( streamPos );
 
     std::vector<Token> arrayTokens = tokenizeArrayData( stream, numElements, typeToken.kind() );
@@ -216,12 +265,45 @@ std::vector<Token> BinaryTokenizer::tokenizeArrayTagKey( std::istream& stream )
     return tokens;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// The array keyword, type, name and number of elements. The array keyword has already been read,
+/// and the stream is left at the first value.
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> BinaryTokenizer::tokenizeArrayHeader( std::istream& stream, const Token& arrayToken )
+{
+    std::vector<Token> tokens;
+    tokens.push_back( arrayToken );
+    tokens.push_back( tokenizeSimpleType( stream ) );
+    tokens.push_back( tokenizeName( stream ) );
+
+    auto numElementsToken = tokenizeNumber( stream, Token::Kind::INT );
+    if ( !numElementsToken )
+    {
+        throw std::runtime_error( "Expected numeric value" );
+    }
+    tokens.push_back( numElementsToken.value() );
+
+    return tokens;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
 std::vector<Token> BinaryTokenizer::tokenizeArrayData( std::istream& stream, size_t numElements, Token::Kind kind )
 {
-    if ( kind == Token::Kind::CHAR )
+    if ( kind == Token::Kind::CHAR && m_parseMode == ParseMode::HEADER_ONLY )
+    {
+        // Skip to after the last zero terminator, the strings are split when read.
+        auto start = stream.tellg();
+        for ( size_t i = 0; i < numElements; i++ )
+        {
+            stream.ignore( std::numeric_limits<std::streamsize>::max(), '\0' );
+        }
+
+        if ( !stream.good() ) throw std::runtime_error( "Unexpected end of file." );
+        return { Token( Token::Kind::ARRAYBLOB, start, stream.tellg() ) };
+    }
+    else if ( kind == Token::Kind::CHAR )
     {
         std::vector<Token> tokens;
         for ( size_t i = 0; i < numElements; i++ )
@@ -37,15 +37,28 @@ public:
     bool                 tokenizeSpace( std::istream& stream ) override;
     std::optional<Token> tokenizeString( std::istream& stream ) override;
     Token                tokenizeName( std::istream& stream ) override;
-    std::vector<Token>   tokenizeArrayTagKey( std::istream& stream ) override;
+    std::vector<Token>   tokenizeArrayTagKey( std::istream& stream, const Token& arrayToken ) override;
+    std::vector<Token>   tokenizeArrayHeader( std::istream& stream, const Token& arrayToken ) override;
     std::optional<Token> tokenizeWord( std::istream& stream, const std::string& keywork, Token::Kind kind ) override;
+    std::vector<Token>   tokenizeTagGroup( std::istream& stream ) override;
 
     std::optional<Token> tokenizeNumber( std::istream& stream, Token::Kind kind );
     std::optional<Token> tokenizeValue( std::istream& stream, Token::Kind kind );
     std::vector<Token>   tokenizeArrayData( std::istream& stream, size_t numElements, Token::Kind kind );
 
+    // True when the filedata.byteswaptest value shows that the file has the opposite byte order.
+    bool swapBytes() const;
+
+    // Sets the byte order from an int key of the filedata tag. Keys other than byteswaptest are ignored.
+    void detectByteOrder( const Token& nameToken, const Token& valueToken, std::istream& stream );
+
 protected:
-    std::vector<Token>   tokenizeTagKeyInternal( std::istream& stream ) override;
+    std::vector<Token>   tokenizeTagKeyInternal( std::istream& stream, const Token& typeToken ) override;
     std::optional<Token> tokenizeStringInternal( std::istream& stream, bool skipDelimiter );
+
+private:
+    int readInt( const Token& token, std::istream& stream ) const;
+
+    bool m_swapBytes;
 };
 } // namespace roff
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "BinaryWriter.hpp"
+
+#include <variant>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+BinaryWriter::BinaryWriter( std::ostream& stream )
+    : Writer( stream )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeFileType()
+{
+    writeString( Token::kindToString( Token::Kind::ROFF_BIN ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeComment( const std::string& comment )
+{
+    writeString( "#" + comment + "#" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeTagBegin( const std::string& tagName )
+{
+    writeString( Token::kindToString( Token::Kind::TAG ) );
+    writeString( tagName );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeTagEnd()
+{
+    writeString( Token::kindToString( Token::Kind::ENDTAG ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeScalarValue( Token::Kind kind, const std::string& name, const RoffScalar& value )
+{
+    writeString( Token::kindToString( kind ) );
+    writeString( name );
+
+    switch ( kind )
+    {
+        case Token::Kind::INT:
+            writeValues( &std::get<int>( value ), 1 );
+            break;
+        case Token::Kind::FLOAT:
+            writeValues( &std::get<float>( value ), 1 );
+            break;
+        case Token::Kind::DOUBLE:
+            writeValues( &std::get<double>( value ), 1 );
+            break;
+        case Token::Kind::BYTE:
+            writeValues( &std::get<unsigned char>( value ), 1 );
+            break;
+        case Token::Kind::BOOL:
+        {
+            char byte = std::get<bool>( value ) ? 1 : 0;
+            writeValues( &byte, 1 );
+            break;
+        }
+        default:
+            writeString( std::get<std::string>( value ) );
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayBegin( Token::Kind kind, const std::string& name, size_t length )
+{
+    writeString( Token::kindToString( Token::Kind::ARRAY ) );
+    writeString( Token::kindToString( kind ) );
+    writeString( name );
+
+    int arrayLength = static_cast<int>( length );
+    writeValues( &arrayLength, 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayValues( const int* values, size_t count )
+{
+    writeValues( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayValues( const float* values, size_t count )
+{
+    writeValues( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayValues( const double* values, size_t count )
+{
+    writeValues( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayValues( const char* values, size_t count )
+{
+    writeValues( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayValues( const std::string* values, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        writeString( values[i] );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeArrayEnd()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void BinaryWriter::writeString( const std::string& text )
+{
+    m_stream.write( text.c_str(), static_cast<std::streamsize>( text.size() + 1 ) );
+}
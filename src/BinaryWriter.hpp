@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+#include "Writer.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace roff
+{
+//==================================================================================================
+/// Writes binary ROFF files (roff-bin) in the native byte order. Readers detect the byte order from
+/// filedata.byteswaptest.
+//==================================================================================================
+class BinaryWriter : public Writer
+{
+public:
+    explicit BinaryWriter( std::ostream& stream );
+
+protected:
+    void writeFileType() override;
+    void writeComment( const std::string& comment ) override;
+    void writeTagBegin( const std::string& tagName ) override;
+    void writeTagEnd() override;
+    void writeScalarValue( Token::Kind kind, const std::string& name, const RoffScalar& value ) override;
+    void writeArrayBegin( Token::Kind kind, const std::string& name, size_t length ) override;
+    void writeArrayValues( const int* values, size_t count ) override;
+    void writeArrayValues( const float* values, size_t count ) override;
+    void writeArrayValues( const double* values, size_t count ) override;
+    void writeArrayValues( const char* values, size_t count ) override;
+    void writeArrayValues( const std::string* values, size_t count ) override;
+    void writeArrayEnd() override;
+
+private:
+    // Text followed by the zero byte delimiter.
+    void writeString( const std::string& text );
+
+    template <typename T>
+    void writeValues( const T* values, size_t count )
+    {
+        m_stream.write( reinterpret_cast<const char*>( values ), static_cast<std::streamsize>( count * sizeof( T ) ) );
+    }
+};
+} // namespace roff
@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "ByteSwap.hpp"
+
+#include <cstdint>
+
+#if defined( __SSSE3__ )
+#include <tmmintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ROFFCPP_BYTESWAP_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#endif
+
+using namespace roff;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <size_t N>
+void swapScalar( unsigned char* bytes, size_t count )
+{
+    for ( size_t i = 0; i < count; i++, bytes += N )
+    {
+        for ( size_t j = 0; j < N / 2; j++ )
+        {
+            unsigned char tmp = bytes[j];
+            bytes[j]          = bytes[N - 1 - j];
+            bytes[N - 1 - j]  = tmp;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Swaps 16 bytes at a time, the remaining values one by one. The values do not need to be aligned.
+//--------------------------------------------------------------------------------------------------
+template <size_t N>
+void swapArray( void* values, size_t count )
+{
+    static_assert( N == 4 || N == 8 );
+
+    auto   bytes     = static_cast<unsigned char*>( values );
+    size_t numBlocks = count * N / 16;
+
+#if defined( __SSSE3__ )
+    const __m128i mask = N == 4 ? _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 )
+                                : _mm_setr_epi8( 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 );
+    for ( size_t i = 0; i < numBlocks; i++, bytes += 16 )
+    {
+        __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( bytes ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( bytes ), _mm_shuffle_epi8( block, mask ) );
+    }
+#elif defined( ROFFCPP_BYTESWAP_SSE2 )
+    // Swap the bytes of each 16 bit word, then reverse the order of the words in each value.
+    for ( size_t i = 0; i < numBlocks; i++, bytes += 16 )
+    {
+        __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( bytes ) );
+        block         = _mm_or_si128( _mm_slli_epi16( block, 8 ), _mm_srli_epi16( block, 8 ) );
+        if constexpr ( N == 4 )
+        {
+            block = _mm_shufflelo_epi16( block, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+            block = _mm_shufflehi_epi16( block, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+        }
+        else
+        {
+            block = _mm_shufflelo_epi16( block, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+            block = _mm_shufflehi_epi16( block, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+        }
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( bytes ), block );
+    }
+#elif defined( __ARM_NEON )
+    for ( size_t i = 0; i < numBlocks; i++, bytes += 16 )
+    {
+        uint8x16_t block = vld1q_u8( bytes );
+        vst1q_u8( bytes, N == 4 ? vrev32q_u8( block ) : vrev64q_u8( block ) );
+    }
+#else
+    numBlocks = 0;
+#endif
+
+    swapScalar<N>( bytes, count - numBlocks * 16 / N );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+T swappedValue( T value )
+{
+    swapScalar<sizeof( T )>( reinterpret_cast<unsigned char*>( &value ), 1 );
+    return value;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void ByteSwap::swap( int* values, size_t count )
+{
+    swapArray<sizeof( int )>( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void ByteSwap::swap( float* values, size_t count )
+{
+    swapArray<sizeof( float )>( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void ByteSwap::swap( double* values, size_t count )
+{
+    swapArray<sizeof( double )>( values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Single bytes have no byte order.
+//--------------------------------------------------------------------------------------------------
+void ByteSwap::swap( char* /*values*/, size_t /*count*/ )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int ByteSwap::swapped( int value )
+{
+    return swappedValue( value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+float ByteSwap::swapped( float value )
+{
+    return swappedValue( value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+double ByteSwap::swapped( double value )
+{
+    return swappedValue( value );
+}
@@ -0,0 +1,41 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace roff
+{
+//==================================================================================================
+/// Reverses the byte order of values, for reading files written with the opposite endianness.
+/// Arrays are swapped with SIMD byte shuffles where available.
+//==================================================================================================
+class ByteSwap
+{
+public:
+    static void swap( int* values, size_t count );
+    static void swap( float* values, size_t count );
+    static void swap( double* values, size_t count );
+    static void swap( char* values, size_t count );
+
+    static int    swapped( int value );
+    static float  swapped( float value );
+    static double swapped( double value );
+};
+} // namespace roff
@@ -0,0 +1,51 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ArrayView.hpp"
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+
+#include <string>
+#include <variant>
+
+namespace roff
+{
+// Values of one chunk of an array. The values are only valid during the callback.
+typedef std::variant<ArrayView<int>, ArrayView<float>, ArrayView<double>, ArrayView<char>, ArrayView<std::string>>
+    ArrayChunk;
+
+//==================================================================================================
+/// Receives the contents of a file, in file order, from StreamReader.
+/// All events are ignored by default.
+//==================================================================================================
+class EventHandler
+{
+public:
+    virtual ~EventHandler();
+
+    virtual void onTagBegin( const std::string& tagName );
+    virtual void onScalar( const std::string& name, const RoffScalar& value );
+    virtual void onArrayBegin( const std::string& name, Token::Kind kind, size_t length );
+
+    // offset is the index of the first value of the chunk in the array.
+    virtual void onArrayChunk( const std::string& name, const ArrayChunk& values, size_t offset );
+    virtual void onTagEnd( const std::string& tagName );
+};
+} // namespace roff
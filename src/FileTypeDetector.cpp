@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "FileTypeDetector.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <string_view>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+/// The keyword must be followed by a delimiter: a zero byte (binary) or whitespace (ascii).
+//--------------------------------------------------------------------------------------------------
+FileType FileTypeDetector::detect( const char* data, size_t size )
+{
+    size_t start = 0;
+    while ( start < size && std::isspace( static_cast<unsigned char>( data[start] ) ) )
+    {
+        start++;
+    }
+
+    constexpr std::string_view binaryKeyword = "roff-bin";
+    constexpr std::string_view asciiKeyword  = "roff-asc";
+    constexpr size_t           length        = binaryKeyword.size();
+    if ( size - start < length ) return FileType::UNKNOWN;
+
+    std::string_view word( data + start, length );
+    if ( start + length < size )
+    {
+        unsigned char delimiter = static_cast<unsigned char>( data[start + length] );
+        if ( delimiter != '\0' && !std::isspace( delimiter ) ) return FileType::UNKNOWN;
+    }
+
+    if ( word == binaryKeyword ) return FileType::ROFF_BIN;
+    if ( word == asciiKeyword ) return FileType::ROFF_ASC;
+    return FileType::UNKNOWN;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+FileType FileTypeDetector::detect( std::istream& stream )
+{
+    std::streambuf* buffer = stream.rdbuf();
+    if ( !buffer || !stream.good() ) return FileType::UNKNOWN;
+
+    auto start = buffer->pubseekoff( 0, std::ios::cur, std::ios::in );
+
+    char            header[headerSize()];
+    std::streamsize size = buffer->sgetn( header, static_cast<std::streamsize>( headerSize() ) );
+
+    bool isRestored = true;
+    if ( start != std::streampos( -1 ) )
+    {
+        isRestored = buffer->pubseekpos( start, std::ios::in ) == start;
+    }
+    else
+    {
+        for ( std::streamsize i = size; i > 0 && isRestored; i-- )
+        {
+            isRestored = buffer->sungetc() != std::char_traits<char>::eof();
+        }
+    }
+    if ( !isRestored ) stream.setstate( std::ios::badbit );
+
+    return detect( header, static_cast<size_t>( size ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+FileType FileTypeDetector::detect( const std::string& fileName )
+{
+    std::ifstream stream( fileName, std::ios::binary );
+    if ( !stream.good() ) return FileType::UNKNOWN;
+
+    char header[headerSize()];
+    stream.read( header, static_cast<std::streamsize>( headerSize() ) );
+    return detect( header, static_cast<size_t>( stream.gcount() ) );
+}
@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+namespace roff
+{
+enum class FileType
+{
+    ROFF_BIN,
+    ROFF_ASC,
+    UNKNOWN
+};
+
+//==================================================================================================
+/// Classifies files from the magic bytes at the start ("roff-bin" or "roff-asc"), without running
+/// the tokenizer. Only the first few bytes are looked at.
+//==================================================================================================
+class FileTypeDetector
+{
+public:
+    // Bytes needed to classify a file. Leading whitespace within these bytes is skipped.
+    static constexpr size_t headerSize() { return 16; }
+
+    static FileType detect( const char* data, size_t size );
+
+    // Peeks at the start of the stream without consuming it. The position is restored by seeking, or
+    // by putting the bytes back into the stream buffer for streams that cannot seek (e.g. pipes).
+    static FileType detect( std::istream& stream );
+
+    // Reads only the first bytes of the file. Missing or unreadable files are UNKNOWN.
+    static FileType detect( const std::string& fileName );
+};
+} // namespace roff
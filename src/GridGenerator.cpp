@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "GridGenerator.hpp"
+
+#include "AsciiWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "Writer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+using namespace roff;
+
+namespace
+{
+// Values generated before they are handed to the writer.
+constexpr size_t chunkSize = 1 << 20;
+
+// Values of each node on the fault, which are split between the four columns around the node.
+constexpr char faultSplit = 4;
+
+constexpr float cellSize     = 50.0f;
+constexpr float thickness    = 2.0f;
+constexpr float topDepth     = 1600.0f;
+constexpr float faultThrow   = 15.0f;
+constexpr int   inactiveRate = 20;
+
+//==================================================================================================
+/// Writes an array of known length from values appended one at a time, in chunks.
+//==================================================================================================
+template <typename T>
+class ChunkedArray
+{
+public:
+    ChunkedArray( Writer& writer, const std::string& name, Token::Kind kind, size_t length )
+        : m_writer( writer )
+    {
+        m_writer.beginArray( name, kind, length );
+        m_values.reserve( std::min( chunkSize, length ) );
+    }
+
+    void append( T value )
+    {
+        m_values.push_back( value );
+        if ( m_values.size() == chunkSize ) flush();
+    }
+
+    void finish()
+    {
+        flush();
+        m_writer.endArray();
+    }
+
+private:
+    void flush()
+    {
+        if ( !m_values.empty() ) m_writer.appendArrayValues( m_values.data(), m_values.size() );
+        m_values.clear();
+    }
+
+    Writer&        m_writer;
+    std::vector<T> m_values;
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Deterministic random bits for value number index of an array (splitmix64 finalizer).
+//--------------------------------------------------------------------------------------------------
+uint64_t randomBits( uint64_t arraySeed, uint64_t index )
+{
+    uint64_t z = arraySeed + ( index + 1 ) * 0x9E3779B97F4A7C15ull;
+    z          = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z          = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    return z ^ ( z >> 31 );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Seed of an array from the grid seed and the array name (FNV-1a), so the values of an array do
+/// not change when other parameters are added.
+//--------------------------------------------------------------------------------------------------
+uint64_t arraySeed( uint64_t seed, const std::string& name )
+{
+    uint64_t hash = 0xCBF29CE484222325ull ^ seed;
+    for ( char c : name )
+    {
+        hash = ( hash ^ static_cast<unsigned char>( c ) ) * 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Uniform value in [0, 1).
+//--------------------------------------------------------------------------------------------------
+double randomUnit( uint64_t arraySeed, uint64_t index )
+{
+    return static_cast<double>( randomBits( arraySeed, index ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Z of the node (i, j, k) in file coordinates: negative depth, with k = 0 at the bottom. The
+/// layers dip gently in both directions.
+//--------------------------------------------------------------------------------------------------
+float nodeZ( const GridGeneratorOptions& options, int i, int j, int k )
+{
+    float depth = topDepth + 0.5f * static_cast<float>( i ) + 0.25f * static_cast<float>( j ) +
+                  thickness * static_cast<float>( options.nZ - k );
+    return -depth;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void GridGenerator::write( Writer& writer, const GridGeneratorOptions& options )
+{
+    if ( options.nX < 1 || options.nY < 1 || options.nZ < 1 ) throw std::runtime_error( "Invalid grid dimensions." );
+    if ( options.numCodes < 1 ) throw std::runtime_error( "Invalid number of codes." );
+
+    size_t nX       = static_cast<size_t>( options.nX );
+    size_t nY       = static_cast<size_t>( options.nY );
+    size_t nZ       = static_cast<size_t>( options.nZ );
+    size_t numCells = nX * nY * nZ;
+    size_t numLines = ( nX + 1 ) * ( nY + 1 );
+    size_t numNodes = numLines * ( nZ + 1 );
+
+    // A vertical fault through the middle of the grid, between the columns i - 1 and i.
+    int    faultI        = options.nX / 2;
+    size_t numFaultNodes = faultI > 0 ? ( nY + 1 ) * ( nZ + 1 ) : 0;
+    size_t numZValues    = numNodes + numFaultNodes * static_cast<size_t>( faultSplit - 1 );
+
+    writer.writeHeader();
+    writer.writeFileData( "grid", "01/01/2000 00:00:00" );
+
+    writer.beginTag( "version" );
+    writer.writeScalar( "major", 2 );
+    writer.writeScalar( "minor", 0 );
+    writer.endTag();
+
+    writer.beginTag( "dimensions" );
+    writer.writeScalar( "nX", options.nX );
+    writer.writeScalar( "nY", options.nY );
+    writer.writeScalar( "nZ", options.nZ );
+    writer.endTag();
+
+    writer.beginTag( "translate" );
+    writer.writeScalar( "xoffset", 456000.0f );
+    writer.writeScalar( "yoffset", 5935000.0f );
+    writer.writeScalar( "zoffset", 0.0f );
+    writer.endTag();
+
+    writer.beginTag( "scale" );
+    writer.writeScalar( "xscale", 1.0f );
+    writer.writeScalar( "yscale", 1.0f );
+    writer.writeScalar( "zscale", -1.0f );
+    writer.endTag();
+
+    // Bottom and top point of each pillar.
+    writer.beginTag( "cornerLines" );
+    ChunkedArray<float> cornerLines( writer, "data", Token::Kind::FLOAT, 6 * numLines );
+    for ( int i = 0; i <= options.nX; i++ )
+    {
+        for ( int j = 0; j <= options.nY; j++ )
+        {
+            float x = cellSize * static_cast<float>( i );
+            float y = cellSize * static_cast<float>( j );
+            for ( int k : { 0, options.nZ } )
+            {
+                cornerLines.append( x );
+                cornerLines.append( y );
+                cornerLines.append( nodeZ( options, i, j, k ) );
+            }
+        }
+    }
+    cornerLines.finish();
+    writer.endTag();
+
+    writer.beginTag( "zvalues" );
+    ChunkedArray<char> splitEnz( writer, "splitEnz", Token::Kind::BYTE, numNodes );
+    for ( int i = 0; i <= options.nX; i++ )
+    {
+        char split = ( faultI > 0 && i == faultI ) ? faultSplit : 1;
+        for ( size_t n = 0; n < ( nY + 1 ) * ( nZ + 1 ); n++ )
+        {
+            splitEnz.append( split );
+        }
+    }
+    splitEnz.finish();
+
+    // Nodes on the fault have a value for each of the four columns around them, in the order sw
+    // (i - 1, j - 1), se (i, j - 1), nw (i - 1, j) and ne (i, j). The columns from i and up are thrown
+    // down, which lowers the se and ne values.
+    ChunkedArray<float> zvalues( writer, "data", Token::Kind::FLOAT, numZValues );
+    for ( int i = 0; i <= options.nX; i++ )
+    {
+        for ( int j = 0; j <= options.nY; j++ )
+        {
+            for ( int k = 0; k <= options.nZ; k++ )
+            {
+                float z = nodeZ( options, i, j, k );
+                if ( faultI > 0 && i == faultI )
+                {
+                    zvalues.append( z );
+                    zvalues.append( z - faultThrow );
+                    zvalues.append( z );
+                    zvalues.append( z - faultThrow );
+                }
+                else
+                {
+                    zvalues.append( i > faultI && faultI > 0 ? z - faultThrow : z );
+                }
+            }
+        }
+    }
+    zvalues.finish();
+    writer.endTag();
+
+    uint64_t activeSeed = arraySeed( options.seed, "active" );
+    writer.beginTag( "active" );
+    ChunkedArray<char> active( writer, "data", Token::Kind::BOOL, numCells );
+    for ( size_t c = 0; c < numCells; c++ )
+    {
+        active.append( randomBits( activeSeed, c ) % inactiveRate != 0 ? 1 : 0 );
+    }
+    active.finish();
+    writer.endTag();
+
+    for ( const auto& name : options.floatParameters )
+    {
+        uint64_t parameterSeed = arraySeed( options.seed, name );
+        writer.beginTag( "parameter" );
+        writer.writeScalar( "name", name );
+        ChunkedArray<float> values( writer, "data", Token::Kind::FLOAT, numCells );
+        for ( size_t c = 0; c < numCells; c++ )
+        {
+            values.append( static_cast<float>( 0.05 + 0.3 * randomUnit( parameterSeed, c ) ) );
+        }
+        values.finish();
+        writer.endTag();
+    }
+
+    std::vector<std::string> codeNames;
+    std::vector<int>         codeValues;
+    for ( int code = 1; code <= options.numCodes; code++ )
+    {
+        codeNames.push_back( "Code " + std::to_string( code ) );
+        codeValues.push_back( code );
+    }
+
+    for ( const auto& name : options.intParameters )
+    {
+        uint64_t parameterSeed = arraySeed( options.seed, name );
+        writer.beginTag( "parameter" );
+        writer.writeScalar( "name", name );
+        writer.writeArray( "codeNames", codeNames );
+        writer.writeArray( "codeValues", codeValues.data(), codeValues.size() );
+        ChunkedArray<int> values( writer, "data", Token::Kind::INT, numCells );
+        for ( size_t c = 0; c < numCells; c++ )
+        {
+            values.append( codeValues[randomBits( parameterSeed, c ) % codeValues.size()] );
+        }
+        values.finish();
+        writer.endTag();
+    }
+
+    writer.finish();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void GridGenerator::write( const std::string& fileName, FileType fileType, const GridGeneratorOptions& options )
+{
+    std::unique_ptr<Writer> writer;
+    std::ofstream           stream;
+    if ( fileType == FileType::ROFF_BIN || fileType == FileType::ROFF_ASC )
+    {
+        stream.open( fileName, std::ios::binary );
+        if ( !stream ) throw std::runtime_error( "Failed to open " + fileName );
+    }
+
+    if ( fileType == FileType::ROFF_BIN )
+        writer = std::make_unique<BinaryWriter>( stream );
+    else if ( fileType == FileType::ROFF_ASC )
+        writer = std::make_unique<AsciiWriter>( stream );
+    else
+        throw std::runtime_error( "Unsupported file type." );
+
+    write( *writer, options );
+}
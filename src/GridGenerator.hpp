@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FileTypeDetector.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace roff
+{
+class Writer;
+
+// Dimensions and parameters of a generated grid.
+struct GridGeneratorOptions
+{
+    int                      nX              = 10;
+    int                      nY              = 10;
+    int                      nZ              = 10;
+    std::vector<std::string> floatParameters = { "PORO" };
+    std::vector<std::string> intParameters   = { "FACIES" };
+    int                      numCodes        = 2;
+    uint64_t                 seed            = 0;
+};
+
+//==================================================================================================
+/// Writes synthetic corner point grids of any size, with the structure of grids exported by RMS:
+/// cornerLines, zvalues with splitEnz, active, and float and int parameters (the int parameters with
+/// codeNames and codeValues). The contents only depend on the options, so files are reproducible.
+/// Arrays are generated and written in chunks, so memory use does not depend on the grid size.
+//==================================================================================================
+class GridGenerator
+{
+public:
+    static void write( Writer& writer, const GridGeneratorOptions& options );
+
+    // Writes a binary (ROFF_BIN) or ASCII (ROFF_ASC) file.
+    static void write( const std::string& fileName, FileType fileType, const GridGeneratorOptions& options );
+};
+} // namespace roff
@@ -0,0 +1,269 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "IndexFile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <variant>
+
+using namespace roff;
+
+namespace
+{
+constexpr char     magic[8] = { 'r', 'o', 'f', 'f', 'i', 'd', 'x', '\0' };
+constexpr uint32_t version  = 2;
+
+//--------------------------------------------------------------------------------------------------
+/// Size and modification time of the file, to detect changes since the index was written.
+//--------------------------------------------------------------------------------------------------
+std::pair<uint64_t, int64_t> fileStamp( const std::string& fileName )
+{
+    uint64_t size         = std::filesystem::file_size( fileName );
+    int64_t  modifiedTime = std::filesystem::last_write_time( fileName ).time_since_epoch().count();
+    return std::make_pair( size, modifiedTime );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void writeValue( std::ostream& stream, T value )
+{
+    stream.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeString( std::ostream& stream, const std::string& value )
+{
+    writeValue<uint32_t>( stream, static_cast<uint32_t>( value.size() ) );
+    stream.write( value.data(), static_cast<std::streamsize>( value.size() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+T readValue( std::istream& stream )
+{
+    T value;
+    if ( !stream.read( reinterpret_cast<char*>( &value ), sizeof( T ) ) )
+    {
+        throw std::runtime_error( "Unexpected end of index file." );
+    }
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::string readString( std::istream& stream )
+{
+    std::string value( readValue<uint32_t>( stream ), '\0' );
+    if ( !stream.read( value.data(), static_cast<std::streamsize>( value.size() ) ) )
+    {
+        throw std::runtime_error( "Unexpected end of index file." );
+    }
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeScalar( std::ostream& stream, const RoffScalar& value )
+{
+    writeValue<uint8_t>( stream, static_cast<uint8_t>( value.index() ) );
+    if ( auto intValue = std::get_if<int>( &value ) )
+        writeValue<int32_t>( stream, *intValue );
+    else if ( auto floatValue = std::get_if<float>( &value ) )
+        writeValue<float>( stream, *floatValue );
+    else if ( auto doubleValue = std::get_if<double>( &value ) )
+        writeValue<double>( stream, *doubleValue );
+    else if ( auto byteValue = std::get_if<unsigned char>( &value ) )
+        writeValue<uint8_t>( stream, *byteValue );
+    else if ( auto boolValue = std::get_if<bool>( &value ) )
+        writeValue<uint8_t>( stream, *boolValue ? 1 : 0 );
+    else
+        writeString( stream, std::get<std::string>( value ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RoffScalar readScalar( std::istream& stream )
+{
+    switch ( readValue<uint8_t>( stream ) )
+    {
+        case 0:
+            return RoffScalar( static_cast<int>( readValue<int32_t>( stream ) ) );
+        case 1:
+            return RoffScalar( readValue<float>( stream ) );
+        case 2:
+            return RoffScalar( readValue<double>( stream ) );
+        case 3:
+            return RoffScalar( static_cast<unsigned char>( readValue<uint8_t>( stream ) ) );
+        case 4:
+            return RoffScalar( readValue<uint8_t>( stream ) != 0 );
+        case 5:
+            return RoffScalar( readString( stream ) );
+        default:
+            throw std::runtime_error( "Invalid scalar in index file." );
+    }
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::string IndexFile::path( const std::string& fileName )
+{
+    return fileName + ".roffidx";
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Written to a temporary file which is then renamed, so that readers never see a partial index.
+//--------------------------------------------------------------------------------------------------
+bool IndexFile::write( const std::string& fileName, const Contents& contents )
+{
+    std::string indexPath = path( fileName );
+    std::string tmpPath   = indexPath + "." + std::to_string( std::random_device()() );
+
+    try
+    {
+        auto [fileSize, modifiedTime] = fileStamp( fileName );
+
+        {
+            std::ofstream stream( tmpPath, std::ios::binary | std::ios::trunc );
+            if ( !stream ) return false;
+
+            stream.write( magic, sizeof( magic ) );
+            writeValue<uint32_t>( stream, version );
+            writeValue<uint32_t>( stream, 1 ); // Byte order of the index
+            writeValue<uint64_t>( stream, fileSize );
+            writeValue<int64_t>( stream, modifiedTime );
+            writeValue<uint8_t>( stream, static_cast<uint8_t>( contents.parseMode ) );
+            writeValue<uint8_t>( stream, contents.isBinary ? 1 : 0 );
+            writeValue<uint8_t>( stream, contents.swapBytes ? 1 : 0 );
+
+            writeValue<uint32_t>( stream, static_cast<uint32_t>( contents.scalarValues.size() ) );
+            for ( const auto& [name, value] : contents.scalarValues )
+            {
+                writeString( stream, name );
+                writeScalar( stream, value );
+            }
+
+            writeValue<uint32_t>( stream, static_cast<uint32_t>( contents.arrays.size() ) );
+            for ( const auto& array : contents.arrays )
+            {
+                writeString( stream, array.name );
+                writeValue<uint8_t>( stream, static_cast<uint8_t>( array.kind ) );
+                writeValue<int64_t>( stream, array.length );
+                writeValue<uint32_t>( stream, static_cast<uint32_t>( array.tokens.size() ) );
+                for ( const auto& token : array.tokens )
+                {
+                    writeValue<uint8_t>( stream, static_cast<uint8_t>( token.kind() ) );
+                    writeValue<uint64_t>( stream, token.start() );
+                    writeValue<uint64_t>( stream, token.end() );
+                }
+            }
+
+            if ( !stream.flush() ) throw std::runtime_error( "Unable to write index file." );
+        }
+
+        std::filesystem::rename( tmpPath, indexPath );
+        return true;
+    }
+    catch ( std::exception& )
+    {
+        std::error_code error;
+        std::filesystem::remove( tmpPath, error );
+        return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<IndexFile::Contents> IndexFile::read( const std::string& fileName, ParseMode parseMode )
+{
+    try
+    {
+        std::ifstream stream( path( fileName ), std::ios::binary );
+        if ( !stream ) return {};
+
+        char fileMagic[sizeof( magic )];
+        if ( !stream.read( fileMagic, sizeof( fileMagic ) ) ) return {};
+        if ( !std::equal( magic, magic + sizeof( magic ), fileMagic ) ) return {};
+        if ( readValue<uint32_t>( stream ) != version || readValue<uint32_t>( stream ) != 1 ) return {};
+
+        auto [fileSize, modifiedTime] = fileStamp( fileName );
+        if ( readValue<uint64_t>( stream ) != fileSize || readValue<int64_t>( stream ) != modifiedTime ) return {};
+
+        // The tokens of a header only parse cannot be used for a full parse, and the other way around.
+        if ( readValue<uint8_t>( stream ) != static_cast<uint8_t>( parseMode ) ) return {};
+
+        Contents contents;
+        contents.parseMode = parseMode;
+        contents.isBinary  = readValue<uint8_t>( stream ) != 0;
+        contents.swapBytes = readValue<uint8_t>( stream ) != 0;
+
+        uint32_t numScalars = readValue<uint32_t>( stream );
+        for ( uint32_t i = 0; i < numScalars; i++ )
+        {
+            std::string name = readString( stream );
+            contents.scalarValues.push_back( std::make_pair( name, readScalar( stream ) ) );
+        }
+
+        uint32_t numArrays = readValue<uint32_t>( stream );
+        for ( uint32_t i = 0; i < numArrays; i++ )
+        {
+            Array array;
+            array.name   = readString( stream );
+            array.kind   = static_cast<Token::Kind>( readValue<uint8_t>( stream ) );
+            array.length = static_cast<long>( readValue<int64_t>( stream ) );
+
+            uint32_t numTokens = readValue<uint32_t>( stream );
+            for ( uint32_t j = 0; j < numTokens; j++ )
+            {
+                auto   kind  = static_cast<Token::Kind>( readValue<uint8_t>( stream ) );
+                size_t start = readValue<uint64_t>( stream );
+                size_t end   = readValue<uint64_t>( stream );
+                if ( start > end || end > fileSize ) return {};
+                array.tokens.push_back( Token( kind, start, end ) );
+            }
+
+            // A single blob token, or one token per value.
+            bool isBlob = array.tokens.size() == 1 && array.tokens[0].kind() == Token::Kind::ARRAYBLOB;
+            if ( array.length > 0 && !isBlob && array.tokens.size() != static_cast<size_t>( array.length ) ) return {};
+            contents.arrays.push_back( std::move( array ) );
+        }
+
+        return contents;
+    }
+    catch ( std::exception& )
+    {
+        return {};
+    }
+}
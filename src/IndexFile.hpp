@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ParseMode.hpp"
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Sidecar file (<file>.roffidx) with the parse results of a ROFF file: the scalar values and the
+/// type, length and value tokens of each array. Arrays can be read using the index without
+/// tokenizing the file again. The index is only valid for a file with the same size and
+/// modification time as when the index was written, and for the parse mode it was written with.
+//==================================================================================================
+class IndexFile
+{
+public:
+    struct Array
+    {
+        std::string        name;
+        Token::Kind        kind;
+        long               length;
+        std::vector<Token> tokens;
+    };
+
+    struct Contents
+    {
+        ParseMode                                       parseMode;
+        bool                                            isBinary;
+        bool                                            swapBytes;
+        std::vector<std::pair<std::string, RoffScalar>> scalarValues;
+        std::vector<Array>                              arrays;
+    };
+
+    static std::string path( const std::string& fileName );
+
+    // Writes the index next to the file. Returns false if the index could not be written.
+    static bool write( const std::string& fileName, const Contents& contents );
+
+    // Contents of the index of the file, if there is a valid index written with the same parse mode.
+    static std::optional<Contents> read( const std::string& fileName, ParseMode parseMode );
+};
+} // namespace roff
@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "LookaheadStreamBuffer.hpp"
+
+#include <algorithm>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+LookaheadStreamBuffer::LookaheadStreamBuffer( std::streambuf& source, size_t blockSize )
+    : m_source( source )
+    , m_blockSize( std::max( blockSize, size_t( 1 ) ) )
+    , m_dataStart( 0 )
+    , m_releasePosition( 0 )
+    , m_isAtEnd( false )
+{
+    setg( nullptr, nullptr, nullptr );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void LookaheadStreamBuffer::release( size_t position )
+{
+    m_releasePosition = std::max( m_releasePosition, std::min( position, this->position() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t LookaheadStreamBuffer::position() const
+{
+    return m_dataStart + static_cast<size_t>( gptr() - eback() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Appends the next block of the source. Released bytes are dropped first when they are at least
+/// half of the kept bytes, so each byte is moved a bounded number of times.
+//--------------------------------------------------------------------------------------------------
+bool LookaheadStreamBuffer::readBlock()
+{
+    if ( m_isAtEnd ) return false;
+
+    size_t index = position() - m_dataStart;
+
+    size_t numReleased = m_releasePosition - m_dataStart;
+    if ( numReleased > 0 && 2 * numReleased >= m_data.size() )
+    {
+        m_data.erase( m_data.begin(), m_data.begin() + static_cast<std::ptrdiff_t>( numReleased ) );
+        m_dataStart = m_releasePosition;
+        index -= numReleased;
+    }
+
+    size_t oldSize = m_data.size();
+    m_data.resize( oldSize + m_blockSize );
+    auto numRead = m_source.sgetn( m_data.data() + oldSize, static_cast<std::streamsize>( m_blockSize ) );
+    m_data.resize( oldSize + static_cast<size_t>( std::max( numRead, std::streamsize( 0 ) ) ) );
+    m_isAtEnd = numRead <= 0;
+
+    setg( m_data.data(), m_data.data() + index, m_data.data() + m_data.size() );
+    return !m_isAtEnd;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+LookaheadStreamBuffer::int_type LookaheadStreamBuffer::underflow()
+{
+    while ( gptr() == egptr() )
+    {
+        if ( !readBlock() ) return traits_type::eof();
+    }
+
+    return traits_type::to_int_type( *gptr() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+LookaheadStreamBuffer::pos_type
+    LookaheadStreamBuffer::seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which )
+{
+    // The end of the source is not known without reading all of it.
+    if ( !( which & std::ios_base::in ) || direction == std::ios_base::end ) return pos_type( off_type( -1 ) );
+
+    off_type target = offset;
+    if ( direction == std::ios_base::cur ) target += static_cast<off_type>( position() );
+
+    if ( target < static_cast<off_type>( m_releasePosition ) ) return pos_type( off_type( -1 ) );
+
+    while ( target > static_cast<off_type>( m_dataStart + m_data.size() ) )
+    {
+        if ( !readBlock() ) return pos_type( off_type( -1 ) );
+    }
+
+    size_t index = static_cast<size_t>( target ) - m_dataStart;
+    setg( m_data.data(), m_data.data() + index, m_data.data() + m_data.size() );
+    return pos_type( target );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+LookaheadStreamBuffer::pos_type LookaheadStreamBuffer::seekpos( pos_type position, std::ios_base::openmode which )
+{
+    return seekoff( off_type( position ), std::ios_base::beg, which );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::streamsize LookaheadStreamBuffer::showmanyc()
+{
+    return static_cast<std::streamsize>( egptr() - gptr() );
+}
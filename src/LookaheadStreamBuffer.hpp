@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Read-only stream buffer over another stream buffer that does not need to be seekable (e.g. a
+/// pipe). The bytes read from the source are kept until they are released, and seeks can move
+/// anywhere in the kept bytes. Seeking forward reads ahead from the source. Stream positions count
+/// from the first byte read from the source.
+//==================================================================================================
+class LookaheadStreamBuffer : public std::streambuf
+{
+public:
+    explicit LookaheadStreamBuffer( std::streambuf& source, size_t blockSize = 65536 );
+
+    // Bytes before the position are no longer needed, seeking back before it fails afterwards.
+    void release( size_t position );
+
+    // Position of the next byte to read.
+    size_t position() const;
+
+protected:
+    int_type underflow() override;
+    pos_type seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which ) override;
+    pos_type seekpos( pos_type position, std::ios_base::openmode which ) override;
+    std::streamsize showmanyc() override;
+
+private:
+    bool readBlock();
+
+    std::streambuf&   m_source;
+    size_t            m_blockSize;
+    std::vector<char> m_data;
+    size_t            m_dataStart;
+    size_t            m_releasePosition;
+    bool              m_isAtEnd;
+};
+} // namespace roff
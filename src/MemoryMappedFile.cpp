@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryMappedFile.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace roff;
+
+#ifdef _WIN32
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile( const std::string& fileName )
+    : m_data( nullptr )
+    , m_size( 0 )
+    , m_fileHandle( INVALID_HANDLE_VALUE )
+    , m_mappingHandle( nullptr )
+{
+    m_fileHandle = CreateFileA( fileName.c_str(),
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                nullptr );
+    if ( m_fileHandle == INVALID_HANDLE_VALUE ) throw std::runtime_error( "Unable to open file: " + fileName );
+
+    LARGE_INTEGER fileSize;
+    if ( !GetFileSizeEx( m_fileHandle, &fileSize ) )
+    {
+        CloseHandle( m_fileHandle );
+        throw std::runtime_error( "Unable to get size of file: " + fileName );
+    }
+
+    m_size = static_cast<size_t>( fileSize.QuadPart );
+
+    // Mapping an empty file is an error on Windows: keep the empty range instead.
+    if ( m_size == 0 ) return;
+
+    m_mappingHandle = CreateFileMappingA( m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( m_mappingHandle == nullptr )
+    {
+        CloseHandle( m_fileHandle );
+        throw std::runtime_error( "Unable to map file: " + fileName );
+    }
+
+    m_data = static_cast<const char*>( MapViewOfFile( m_mappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+    if ( m_data == nullptr )
+    {
+        CloseHandle( m_mappingHandle );
+        CloseHandle( m_fileHandle );
+        throw std::runtime_error( "Unable to map file: " + fileName );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if ( m_data ) UnmapViewOfFile( m_data );
+    if ( m_mappingHandle ) CloseHandle( m_mappingHandle );
+    if ( m_fileHandle != INVALID_HANDLE_VALUE ) CloseHandle( m_fileHandle );
+}
+
+#else
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile( const std::string& fileName )
+    : m_data( nullptr )
+    , m_size( 0 )
+{
+    int fd = open( fileName.c_str(), O_RDONLY );
+    if ( fd < 0 ) throw std::runtime_error( "Unable to open file: " + fileName );
+
+    struct stat fileStat;
+    if ( fstat( fd, &fileStat ) != 0 || !S_ISREG( fileStat.st_mode ) )
+    {
+        close( fd );
+        throw std::runtime_error( "Unable to map file: " + fileName );
+    }
+
+    m_size = static_cast<size_t>( fileStat.st_size );
+
+    // mmap rejects zero-length mappings: keep the empty range instead.
+    if ( m_size == 0 )
+    {
+        close( fd );
+        return;
+    }
+
+    void* address = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping keeps its own reference to the file.
+    close( fd );
+
+    if ( address == MAP_FAILED ) throw std::runtime_error( "Unable to map file: " + fileName );
+
+    m_data = static_cast<const char*>( address );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if ( m_data ) munmap( const_cast<char*>( m_data ), m_size );
+}
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const char* MemoryMappedFile::data() const
+{
+    return m_data;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t MemoryMappedFile::size() const
+{
+    return m_size;
+}
@@ -0,0 +1,51 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace roff
+{
+//==================================================================================================
+/// Read-only memory mapping of a whole file. Throws std::runtime_error if the file
+/// cannot be opened or mapped.
+//==================================================================================================
+class MemoryMappedFile
+{
+public:
+    explicit MemoryMappedFile( const std::string& fileName );
+    ~MemoryMappedFile();
+
+    MemoryMappedFile( const MemoryMappedFile& )            = delete;
+    MemoryMappedFile& operator=( const MemoryMappedFile& ) = delete;
+
+    const char* data() const;
+    size_t      size() const;
+
+private:
+    const char* m_data;
+    size_t      m_size;
+
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
+} // namespace roff
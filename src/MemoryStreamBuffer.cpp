@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryStreamBuffer.hpp"
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryStreamBuffer::MemoryStreamBuffer( const char* data, size_t size, size_t startPosition )
+    : m_data( data )
+    , m_size( size )
+    , m_startPosition( startPosition )
+{
+    // The get area is never written to: the const_cast is only needed by the streambuf interface.
+    char* begin = const_cast<char*>( data );
+    setg( begin, begin, begin + size );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const char* MemoryStreamBuffer::data() const
+{
+    return m_data;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t MemoryStreamBuffer::size() const
+{
+    return m_size;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t MemoryStreamBuffer::startPosition() const
+{
+    return m_startPosition;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryStreamBuffer::pos_type
+    MemoryStreamBuffer::seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which )
+{
+    if ( !( which & std::ios_base::in ) ) return pos_type( off_type( -1 ) );
+
+    off_type base = 0;
+    if ( direction == std::ios_base::cur )
+        base = static_cast<off_type>( gptr() - eback() );
+    else if ( direction == std::ios_base::end )
+        base = static_cast<off_type>( m_size );
+    else
+        base = -static_cast<off_type>( m_startPosition );
+
+    off_type index = base + offset;
+    if ( index < 0 || index > static_cast<off_type>( m_size ) ) return pos_type( off_type( -1 ) );
+
+    setg( eback(), eback() + index, egptr() );
+    return pos_type( static_cast<off_type>( m_startPosition ) + index );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos( pos_type position, std::ios_base::openmode which )
+{
+    return seekoff( off_type( position ), std::ios_base::beg, which );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::streamsize MemoryStreamBuffer::showmanyc()
+{
+    return static_cast<std::streamsize>( egptr() - gptr() );
+}
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+
+namespace roff
+{
+//==================================================================================================
+/// Seekable read-only stream buffer over a memory range (e.g. a memory mapped file).
+/// The whole range is the get area, so reads are plain copies and seeks only move the cursor.
+/// The range can also hold part of a larger stream, starting at stream position startPosition.
+//==================================================================================================
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+    MemoryStreamBuffer( const char* data, size_t size, size_t startPosition = 0 );
+
+    const char* data() const;
+    size_t      size() const;
+    size_t      startPosition() const;
+
+protected:
+    pos_type seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which ) override;
+    pos_type seekpos( pos_type position, std::ios_base::openmode which ) override;
+    std::streamsize showmanyc() override;
+
+private:
+    const char* m_data;
+    size_t      m_size;
+    size_t      m_startPosition;
+};
+} // namespace roff
@@ -18,8 +18,11 @@
 
 #include "Parser.hpp"
 
+#include "MemoryStreamBuffer.hpp"
 #include "RoffScalar.hpp"
+#include "ThreadPool.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <stdexcept>
@@ -32,6 +35,7 @@ using namespace roff;
 ///
 //--------------------------------------------------------------------------------------------------
 Parser::Parser()
+    : m_threadPool( &ThreadPool::globalInstance() )
 {
 }
 
@@ -45,11 +49,27 @@ Parser::~Parser()
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void Parser::parse( std::istream&                                     stream,
-                    const std::vector<Token>&                         tokens,
-                    std::vector<std::pair<std::string, RoffScalar>>&  scalarValues,
-                    std::vector<std::pair<std::string, Token::Kind>>& arrayTypes,
-                    std::map<std::string, std::pair<long, long>>&     arrayInfo ) const
+void Parser::setThreadPool( ThreadPool& pool )
+{
+    m_threadPool = &pool;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ThreadPool& Parser::threadPool() const
+{
+    return *m_threadPool;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Parser::parse( std::istream&                                           stream,
+                    const std::vector<Token>&                               tokens,
+                    std::vector<std::pair<std::string, RoffScalar>>&        scalarValues,
+                    std::vector<std::pair<std::string, Token::Kind>>&       arrayTypes,
+                    std::unordered_map<std::string, std::pair<long, long>>& arrayInfo ) const
 {
     auto        it           = tokens.begin();
     std::string tagGroupName = "";
@@ -70,12 +90,6 @@ void Parser::parse( std::istream&                                     stream,
                 lastName = std::get<std::string>( simpleType.second );
             }
 
-            // Only little-endian is supported.
-            if ( simpleType.first == "filedata.byteswaptest" && std::get<int>( simpleType.second ) != 1 )
-            {
-                throw std::runtime_error( "Unexpected endianness." );
-            }
-
             scalarValues.push_back( simpleType );
         }
         else if ( it->kind() == Token::Kind::ARRAY )
@@ -138,8 +152,7 @@ void Parser::parse( std::istream&                                     stream,
 //--------------------------------------------------------------------------------------------------
 bool Parser::isSimpleType( Token::Kind kind )
 {
-    return kind == Token::Kind::INT || kind == Token::Kind::BOOL || kind == Token::Kind::BYTE ||
-           kind == Token::Kind::FLOAT || kind == Token::Kind::DOUBLE || kind == Token::Kind::CHAR;
+    return Token::isSimpleType( kind );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -158,18 +171,91 @@ std::pair<std::string, RoffScalar> Parser::parseSimpleType( std::vector<Token>::
 
     std::advance( it, 1 );
 
-    auto extractValue = [this]( auto it, Token::Kind kind, std::istream& stream )
+    RoffScalar val = parseScalar( kind, *it, stream );
+
+    return std::make_pair( tagGroupName + "." + name, val );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+std::vector<T> Parser::parseArray( const TokenStore& tokens,
+                                   std::istream&     stream,
+                                   long              startIndex,
+                                   long              arrayLength ) const
+{
+    std::vector<T> values( static_cast<size_t>( std::max( arrayLength, 0L ) ) );
+    readArray( tokens, stream, startIndex, arrayLength, 0, values.size(), values.data() );
+    return values;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<int> Parser::parseIntArray( const TokenStore& tokens,
+                                        std::istream&     stream,
+                                        long              startIndex,
+                                        long              arrayLength ) const
+{
+    return parseArray<int>( tokens, stream, startIndex, arrayLength );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<double> Parser::parseDoubleArray( const TokenStore& tokens,
+                                              std::istream&     stream,
+                                              long              startIndex,
+                                              long              arrayLength ) const
+{
+    return parseArray<double>( tokens, stream, startIndex, arrayLength );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<float> Parser::parseFloatArray( const TokenStore& tokens,
+                                            std::istream&     stream,
+                                            long              startIndex,
+                                            long              arrayLength ) const
+{
+    return parseArray<float>( tokens, stream, startIndex, arrayLength );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<char> Parser::parseByteArray( const TokenStore& tokens,
+                                          std::istream&     stream,
+                                          long              startIndex,
+                                          long              arrayLength ) const
+{
+    return parseArray<char>( tokens, stream, startIndex, arrayLength );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::string_view Parser::readBytes( std::istream& stream, size_t start, size_t end, std::string& buffer )
+{
+    assert( start <= end );
+
+    auto memoryBuffer = dynamic_cast<const MemoryStreamBuffer*>( stream.rdbuf() );
+    if ( memoryBuffer && start >= memoryBuffer->startPosition() &&
+         end <= memoryBuffer->startPosition() + memoryBuffer->size() )
     {
-        if ( kind == Token::Kind::INT ) return RoffScalar( parseInt( *it, stream ) );
-        if ( kind == Token::Kind::BOOL ) return RoffScalar( parseBool( *it, stream ) );
-        if ( kind == Token::Kind::BYTE ) return RoffScalar( parseByte( *it, stream ) );
-        if ( kind == Token::Kind::CHAR ) return RoffScalar( parseString( *it, stream ) );
-        if ( kind == Token::Kind::DOUBLE ) return RoffScalar( parseDouble( *it, stream ) );
-        if ( kind == Token::Kind::FLOAT ) return RoffScalar( parseFloat( *it, stream ) );
-        return RoffScalar( 1 );
-    };
+        return std::string_view( memoryBuffer->data() + ( start - memoryBuffer->startPosition() ), end - start );
+    }
 
-    RoffScalar val = extractValue( it, kind, stream );
+    stream.clear();
+    stream.seekg( start );
+    buffer.resize( end - start );
+    stream.read( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+    if ( static_cast<size_t>( stream.gcount() ) != buffer.size() )
+    {
+        throw std::runtime_error( "Unexpected end of stream." );
+    }
 
-    return std::make_pair( tagGroupName + "." + name, val );
+    return buffer;
 }
@@ -19,54 +19,98 @@
 #pragma once
 
 #include "Token.hpp"
+#include "TokenStore.hpp"
 
 #include "RoffScalar.hpp"
 
 #include <istream>
-#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
 namespace roff
 {
+class ThreadPool;
+
 class Parser
 {
 public:
     Parser();
     virtual ~Parser();
 
-    void parse( std::istream&                                     stream,
-                const std::vector<Token>&                         tokens,
-                std::vector<std::pair<std::string, RoffScalar>>&  scalarValues,
-                std::vector<std::pair<std::string, Token::Kind>>& arrayTypes,
-                std::map<std::string, std::pair<long, long>>&     arrayInfo ) const;
+    // Pool used to decode large arrays, the global pool by default.
+    void setThreadPool( ThreadPool& pool );
+
+    void parse( std::istream&                                           stream,
+                const std::vector<Token>&                               tokens,
+                std::vector<std::pair<std::string, RoffScalar>>&        scalarValues,
+                std::vector<std::pair<std::string, Token::Kind>>&       arrayTypes,
+                std::unordered_map<std::string, std::pair<long, long>>& arrayInfo ) const;
 
     std::pair<std::string, RoffScalar> parseSimpleType( std::vector<Token>::const_iterator& it,
                                                         const std::string&                  tagGroupName,
                                                         std::istream&                       stream ) const;
 
-    virtual std::vector<std::string> parseStringArray( const std::vector<Token>& tokens,
-                                                       std::istream&             stream,
-                                                       long                      startIndex,
-                                                       long                      arrayLength ) const = 0;
+    // Value of a scalar of the given simple type.
+    virtual RoffScalar parseScalar( Token::Kind kind, const Token& token, std::istream& stream ) const = 0;
+
+    virtual std::vector<std::string> parseStringArray( const TokenStore& tokens,
+                                                       std::istream&     stream,
+                                                       long              startIndex,
+                                                       long              arrayLength ) const = 0;
+
+    std::vector<int>
+        parseIntArray( const TokenStore& tokens, std::istream& stream, long startIndex, long arrayLength ) const;
+
+    std::vector<double> parseDoubleArray( const TokenStore& tokens,
+                                          std::istream&     stream,
+                                          long              startIndex,
+                                          long              arrayLength ) const;
+
+    std::vector<float> parseFloatArray( const TokenStore& tokens,
+                                        std::istream&     stream,
+                                        long              startIndex,
+                                        long              arrayLength ) const;
 
-    virtual std::vector<int>
-        parseIntArray( const std::vector<Token>& tokens, std::istream& stream, long startIndex, long arrayLength ) const = 0;
+    std::vector<char> parseByteArray( const TokenStore& tokens,
+                                      std::istream&     stream,
+                                      long              startIndex,
+                                      long              arrayLength ) const;
 
-    virtual std::vector<double> parseDoubleArray( const std::vector<Token>& tokens,
-                                                  std::istream&             stream,
-                                                  long                      startIndex,
-                                                  long                      arrayLength ) const = 0;
+    // Read count values of the array, starting at value number offset, directly into values.
+    virtual void readArray( const TokenStore& tokens,
+                            std::istream&     stream,
+                            long              startIndex,
+                            long              arrayLength,
+                            size_t            offset,
+                            size_t            count,
+                            int*              values ) const = 0;
 
-    virtual std::vector<float> parseFloatArray( const std::vector<Token>& tokens,
-                                                std::istream&             stream,
-                                                long                      startIndex,
-                                                long                      arrayLength ) const = 0;
+    virtual void readArray( const TokenStore& tokens,
+                            std::istream&     stream,
+                            long              startIndex,
+                            long              arrayLength,
+                            size_t            offset,
+                            size_t            count,
+                            double*           values ) const = 0;
 
-    virtual std::vector<char> parseByteArray( const std::vector<Token>& tokens,
-                                              std::istream&             stream,
-                                              long                      startIndex,
-                                              long                      arrayLength ) const = 0;
+    virtual void readArray( const TokenStore& tokens,
+                            std::istream&     stream,
+                            long              startIndex,
+                            long              arrayLength,
+                            size_t            offset,
+                            size_t            count,
+                            float*            values ) const = 0;
+
+    virtual void readArray( const TokenStore& tokens,
+                            std::istream&     stream,
+                            long              startIndex,
+                            long              arrayLength,
+                            size_t            offset,
+                            size_t            count,
+                            char*             values ) const = 0;
 
     virtual std::string   parseString( const Token& token, std::istream& stream ) const = 0;
     virtual int           parseInt( const Token& token, std::istream& stream ) const    = 0;
@@ -80,5 +124,19 @@ public:
     static std::string postFixData() { return ".data"; }
     static std::string postFixCodeNames() { return ".codeNames"; }
     static std::string postFixCodeValues() { return ".codeValues"; }
+
+protected:
+    // Bytes in [start, end) of the stream. Points directly into the memory when the stream reads from
+    // a MemoryStreamBuffer, otherwise the bytes are read into buffer.
+    static std::string_view readBytes( std::istream& stream, size_t start, size_t end, std::string& buffer );
+
+    ThreadPool& threadPool() const;
+
+private:
+    template <typename T>
+    std::vector<T>
+        parseArray( const TokenStore& tokens, std::istream& stream, long startIndex, long arrayLength ) const;
+
+    ThreadPool* m_threadPool;
 };
 } // namespace roff
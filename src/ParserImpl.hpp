@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Parser.hpp"
+#include "Token.hpp"
+#include "TokenStore.hpp"
+
+#include "RoffScalar.hpp"
+
+#include <istream>
+
+namespace roff
+{
+//==================================================================================================
+/// Implements the type dispatch of Parser for a file format. Format is the final parser class, and
+/// provides the scalar functions (parseInt etc.) and
+///
+///     template <typename T>
+///     void readArrayValues( tokens, stream, startIndex, arrayLength, offset, count, T* values ) const;
+///
+/// The calls are bound at compile time, so the format and the value type are known in the decoding
+/// loops. Only the entry point from Parser is virtual.
+//==================================================================================================
+template <typename Format>
+class ParserImpl : public Parser
+{
+public:
+    RoffScalar parseScalar( Token::Kind kind, const Token& token, std::istream& stream ) const override
+    {
+        switch ( kind )
+        {
+            case Token::Kind::INT:
+                return RoffScalar( format().Format::parseInt( token, stream ) );
+            case Token::Kind::BOOL:
+                return RoffScalar( format().Format::parseBool( token, stream ) );
+            case Token::Kind::BYTE:
+                return RoffScalar( format().Format::parseByte( token, stream ) );
+            case Token::Kind::CHAR:
+                return RoffScalar( format().Format::parseString( token, stream ) );
+            case Token::Kind::DOUBLE:
+                return RoffScalar( format().Format::parseDouble( token, stream ) );
+            case Token::Kind::FLOAT:
+                return RoffScalar( format().Format::parseFloat( token, stream ) );
+            default:
+                return RoffScalar( 1 );
+        }
+    }
+
+    void readArray( const TokenStore& tokens,
+                    std::istream&     stream,
+                    long              startIndex,
+                    long              arrayLength,
+                    size_t            offset,
+                    size_t            count,
+                    int*              values ) const override
+    {
+        format().template readArrayValues<int>( tokens, stream, startIndex, arrayLength, offset, count, values );
+    }
+
+    void readArray( const TokenStore& tokens,
+                    std::istream&     stream,
+                    long              startIndex,
+                    long              arrayLength,
+                    size_t            offset,
+                    size_t            count,
+                    double*           values ) const override
+    {
+        format().template readArrayValues<double>( tokens, stream, startIndex, arrayLength, offset, count, values );
+    }
+
+    void readArray( const TokenStore& tokens,
+                    std::istream&     stream,
+                    long              startIndex,
+                    long              arrayLength,
+                    size_t            offset,
+                    size_t            count,
+                    float*            values ) const override
+    {
+        format().template readArrayValues<float>( tokens, stream, startIndex, arrayLength, offset, count, values );
+    }
+
+    void readArray( const TokenStore& tokens,
+                    std::istream&     stream,
+                    long              startIndex,
+                    long              arrayLength,
+                    size_t            offset,
+                    size_t            count,
+                    char*             values ) const override
+    {
+        format().template readArrayValues<char>( tokens, stream, startIndex, arrayLength, offset, count, values );
+    }
+
+private:
+    const Format& format() const { return static_cast<const Format&>( *this ); }
+};
+} // namespace roff
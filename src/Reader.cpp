@@ -22,12 +22,25 @@
 #include "AsciiTokenizer.hpp"
 #include "BinaryParser.hpp"
 #include "BinaryTokenizer.hpp"
+#include "FileTypeDetector.hpp"
+#include "IndexFile.hpp"
 #include "Parser.hpp"
+#include "ThreadPool.hpp"
 #include "Tokenizer.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -38,72 +51,241 @@ using namespace roff;
 //--------------------------------------------------------------------------------------------------
 Reader::Reader( std::istream& stream )
     : m_stream( &stream )
+    , m_useIndexFile( false )
+    , m_isBinary( false )
+    , m_swapBytes( false )
+    , m_threadPool( &ThreadPool::globalInstance() )
 {
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Memory maps the file when possible, so that tokenizing and array reads work directly on the
+/// mapped bytes. Falls back to a regular file stream if the file cannot be mapped.
+//--------------------------------------------------------------------------------------------------
+Reader::Reader( const std::string& fileName )
+    : m_stream( nullptr )
+    , m_fileName( fileName )
+    , m_useIndexFile( false )
+    , m_isBinary( false )
+    , m_swapBytes( false )
+    , m_threadPool( &ThreadPool::globalInstance() )
+{
+    try
+    {
+        m_mappedFile   = std::make_unique<MemoryMappedFile>( fileName );
+        m_mappedBuffer = std::make_unique<MemoryStreamBuffer>( m_mappedFile->data(), m_mappedFile->size() );
+        m_ownedStream  = std::make_unique<std::istream>( m_mappedBuffer.get() );
+    }
+    catch ( std::runtime_error& )
+    {
+        m_mappedFile.reset();
+        m_ownedStream = std::make_unique<std::ifstream>( fileName, std::ios::binary );
+        if ( !m_ownedStream->good() ) throw std::runtime_error( "Unable to open file: " + fileName );
+    }
+
+    m_stream = m_ownedStream.get();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::setTagFilter( TagFilter filter )
+{
+    m_tagFilter = std::move( filter );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void Reader::parse()
+void Reader::setTagFilter( const std::vector<std::string>& names )
 {
-    bool isBinary = detectFileTypeFromFirstToken( *m_stream );
-    if ( isBinary )
+    std::set<std::string> nameSet( names.begin(), names.end() );
+    m_tagFilter = [nameSet]( const std::string& name ) { return nameSet.count( name ) > 0; };
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::setUseIndexFile( bool useIndexFile )
+{
+    m_useIndexFile = useIndexFile;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::parse( ParseMode mode )
+{
+    bool useIndexFile = m_useIndexFile && !m_fileName.empty() && !m_tagFilter;
+    if ( useIndexFile && readIndexFile( mode ) ) return;
+
+    FileType fileType = FileTypeDetector::detect( *m_stream );
+    if ( fileType == FileType::UNKNOWN ) throw std::runtime_error( "Unexpected file type." );
+
+    m_isBinary = fileType == FileType::ROFF_BIN;
+    if ( m_isBinary )
     {
-        parseBinary();
+        parseBinary( mode );
     }
     else
     {
-        parseAscii();
+        parseAscii( mode );
     }
+
+    if ( useIndexFile ) writeIndexFile( mode );
 }
 
 //--------------------------------------------------------------------------------------------------
-///
+/// Restores the parse results from the index. Only the tokens of the array values are kept.
 //--------------------------------------------------------------------------------------------------
-bool Reader::detectFileTypeFromFirstToken( std::istream& stream )
+bool Reader::readIndexFile( ParseMode mode )
 {
-    try
+    std::optional<IndexFile::Contents> contents = IndexFile::read( m_fileName, mode );
+    if ( !contents ) return false;
+
+    m_isBinary     = contents->isBinary;
+    m_swapBytes    = contents->swapBytes;
+    m_scalarValues = std::move( contents->scalarValues );
+    m_arrayTypes.clear();
+
+    std::vector<Token>                                     tokens;
+    std::unordered_map<std::string, std::pair<long, long>> arrayInfo;
+    for ( const auto& array : contents->arrays )
     {
-        // Detect file type from first token
-        BinaryTokenizer tokenizer;
-        Token           token = tokenizer.tokenizeFileType( stream );
-        assert( token.kind() == Token::Kind::ROFF_ASC || token.kind() == Token::Kind::ROFF_BIN );
-        stream.clear();
-        stream.seekg( 0 );
-        return token.kind() == Token::Kind::ROFF_BIN;
+        long startIndex = static_cast<long>( tokens.size() );
+        tokens.insert( tokens.end(), array.tokens.begin(), array.tokens.end() );
+        m_arrayTypes.push_back( std::make_pair( array.name, array.kind ) );
+        arrayInfo[array.name] = std::make_pair( startIndex, array.length );
     }
-    catch ( std::runtime_error& )
+    buildLookupTables( tokens, arrayInfo );
+
+    if ( m_isBinary )
+        m_parser = std::make_unique<BinaryParser>( m_swapBytes );
+    else
+        m_parser = std::make_unique<AsciiParser>();
+    m_parser->setThreadPool( *m_threadPool );
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Failing to write the index is not an error: the file is just tokenized again next time.
+//--------------------------------------------------------------------------------------------------
+void Reader::writeIndexFile( ParseMode mode ) const
+{
+    IndexFile::Contents contents;
+    contents.parseMode    = mode;
+    contents.isBinary     = m_isBinary;
+    contents.swapBytes    = m_swapBytes;
+    contents.scalarValues = m_scalarValues;
+
+    for ( const auto& [name, kind] : m_arrayTypes )
     {
-        throw std::runtime_error( "Unexpected file type." );
+        auto [startIndex, arrayLength] = arrayLocation( name );
+
+        IndexFile::Array array{ name, kind, arrayLength, {} };
+        if ( arrayLength > 0 )
+        {
+            bool isBlob   = m_tokens.kind( startIndex ) == Token::Kind::ARRAYBLOB;
+            long tokenEnd = startIndex + ( isBlob ? 1 : arrayLength );
+            for ( long i = startIndex; i < tokenEnd; i++ )
+            {
+                array.tokens.push_back( m_tokens[i] );
+            }
+        }
+        contents.arrays.push_back( std::move( array ) );
     }
+
+    IndexFile::write( m_fileName, contents );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool Reader::isMemoryMapped() const
+{
+    return m_mappedFile != nullptr;
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void Reader::parseAscii()
+void Reader::parseAscii( ParseMode mode )
 {
     AsciiTokenizer tokenizer;
-    m_tokens = tokenizer.tokenizeStream( *m_stream );
-    m_parser = std::make_unique<AsciiParser>();
-    m_parser->parse( *m_stream, m_tokens, m_scalarValues, m_arrayTypes, m_arrayInfo );
+    tokenizer.setParseMode( mode );
+    tokenizer.setTagFilter( m_tagFilter );
+    std::vector<Token> tokens = tokenizer.tokenizeStream( *m_stream );
+    m_parser                  = std::make_unique<AsciiParser>();
+    m_parser->setThreadPool( *m_threadPool );
+
+    std::unordered_map<std::string, std::pair<long, long>> arrayInfo;
+    m_parser->parse( *m_stream, tokens, m_scalarValues, m_arrayTypes, arrayInfo );
+    buildLookupTables( tokens, arrayInfo );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void Reader::parseBinary()
+void Reader::parseBinary( ParseMode mode )
 {
     BinaryTokenizer tokenizer;
-    m_tokens = tokenizer.tokenizeStream( *m_stream );
-    m_parser = std::make_unique<BinaryParser>();
-    m_parser->parse( *m_stream, m_tokens, m_scalarValues, m_arrayTypes, m_arrayInfo );
+    tokenizer.setParseMode( mode );
+    tokenizer.setTagFilter( m_tagFilter );
+    std::vector<Token> tokens = tokenizer.tokenizeStream( *m_stream );
+    m_swapBytes               = tokenizer.swapBytes();
+    m_parser                  = std::make_unique<BinaryParser>( m_swapBytes );
+    m_parser->setThreadPool( *m_threadPool );
+
+    std::unordered_map<std::string, std::pair<long, long>> arrayInfo;
+    m_parser->parse( *m_stream, tokens, m_scalarValues, m_arrayTypes, arrayInfo );
+    buildLookupTables( tokens, arrayInfo );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Indexes the scalars and arrays by name, so lookups do not scan the lists in file order. Only the
+/// tokens of the array values are kept, in compact form: the other tokens are not needed after parsing.
+//--------------------------------------------------------------------------------------------------
+void Reader::buildLookupTables( const std::vector<Token>&                                     tokens,
+                                const std::unordered_map<std::string, std::pair<long, long>>& arrayInfo )
+{
+    m_scalarIndices.clear();
+    m_scalarIndices.reserve( m_scalarValues.size() );
+    for ( size_t i = 0; i < m_scalarValues.size(); i++ )
+    {
+        m_scalarIndices.emplace( m_scalarValues[i].first, i );
+    }
+
+    m_tokens.clear();
+    m_arrays.clear();
+    m_arrays.reserve( m_arrayTypes.size() );
+    for ( const auto& [name, kind] : m_arrayTypes )
+    {
+        auto it = arrayInfo.find( name );
+        if ( it == arrayInfo.end() || m_arrays.count( name ) > 0 ) continue;
+
+        auto [startIndex, arrayLength] = it->second;
+        long   compactIndex            = static_cast<long>( m_tokens.size() );
+        size_t offset                  = 0;
+        if ( arrayLength > 0 )
+        {
+            bool isBlob   = tokens[startIndex].kind() == Token::Kind::ARRAYBLOB;
+            long tokenEnd = startIndex + ( isBlob ? 1 : arrayLength );
+            for ( long i = startIndex; i < tokenEnd; i++ )
+            {
+                m_tokens.push_back( tokens[i] );
+            }
+            offset = tokens[startIndex].start();
+        }
+        m_arrays[name] = { { kind, static_cast<size_t>( std::max( arrayLength, 0L ) ), offset }, compactIndex };
+    }
+    m_tokens.shrink_to_fit();
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<std::pair<std::string, RoffScalar>> Reader::scalarNamedValues() const
+const std::vector<std::pair<std::string, RoffScalar>>& Reader::scalarNamedValues() const
 {
     return m_scalarValues;
 }
@@ -111,7 +293,7 @@ std::vector<std::pair<std::string, RoffScalar>> Reader::scalarNamedValues() cons
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<std::pair<std::string, Token::Kind>> Reader::getNamedArrayTypes() const
+const std::vector<std::pair<std::string, Token::Kind>>& Reader::getNamedArrayTypes() const
 {
     return m_arrayTypes;
 }
@@ -121,9 +303,9 @@ std::vector<std::pair<std::string, Token::Kind>> Reader::getNamedArrayTypes() co
 //--------------------------------------------------------------------------------------------------
 size_t Reader::getArrayLength( const std::string& keyword ) const
 {
-    auto it = m_arrayInfo.find( keyword );
-    if ( it != m_arrayInfo.end() )
-        return it->second.second;
+    auto it = m_arrays.find( keyword );
+    if ( it != m_arrays.end() )
+        return it->second.info.length;
     else
         return 0;
 }
@@ -131,44 +313,516 @@ size_t Reader::getArrayLength( const std::string& keyword ) const
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<std::string> Reader::getStringArray( const std::string& keyword )
+bool Reader::hasScalar( const std::string& name ) const
+{
+    return m_scalarIndices.count( name ) > 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const RoffScalar& Reader::getScalar( const std::string& name ) const
+{
+    auto it = m_scalarIndices.find( name );
+    if ( it == m_scalarIndices.end() ) throw std::runtime_error( "Missing scalar: " + name );
+    return m_scalarValues[it->second].second;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool Reader::hasArray( const std::string& keyword ) const
+{
+    return m_arrays.count( keyword ) > 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const ArrayInfo& Reader::arrayInfo( const std::string& keyword ) const
+{
+    auto it = m_arrays.find( keyword );
+    if ( it == m_arrays.end() ) throw std::runtime_error( "Missing array: " + keyword );
+    return it->second.info;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start token and length of the array, or an empty array when the keyword is unknown.
+//--------------------------------------------------------------------------------------------------
+std::pair<long, long> Reader::arrayLocation( const std::string& keyword ) const
+{
+    auto it = m_arrays.find( keyword );
+    if ( it != m_arrays.end() )
+        return std::make_pair( it->second.startIndex, static_cast<long>( it->second.info.length ) );
+    else
+        return std::make_pair( 0L, 0L );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Calls read with a stream positioned for this call only. Memory mapped files get a new stream
+/// over the mapping, so concurrent calls do not wait for each other. Other streams have a single
+/// position, and calls using them are serialized: they are thread-safe, but not concurrent. Files
+/// only fall back to a stream when they cannot be mapped, in practice pipes and devices, which
+/// cannot be read at an offset either.
+//--------------------------------------------------------------------------------------------------
+template <typename ReadFunction>
+auto Reader::withStream( ReadFunction read ) const
+{
+    if ( m_mappedFile )
+    {
+        MemoryStreamBuffer buffer( m_mappedFile->data(), m_mappedFile->size() );
+        std::istream       stream( &buffer );
+        return read( stream );
+    }
+
+    std::lock_guard<std::mutex> lock( m_streamMutex );
+    return read( *m_stream );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<std::string> Reader::getStringArray( const std::string& keyword ) const
+{
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    return withStream( [&]( std::istream& stream )
+                       { return m_parser->parseStringArray( m_tokens, stream, startIndex, arrayLength ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<int> Reader::getIntArray( const std::string& keyword ) const
+{
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    return withStream( [&]( std::istream& stream )
+                       { return m_parser->parseIntArray( m_tokens, stream, startIndex, arrayLength ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<char> Reader::getByteArray( const std::string& keyword ) const
+{
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    return withStream( [&]( std::istream& stream )
+                       { return m_parser->parseByteArray( m_tokens, stream, startIndex, arrayLength ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<float> Reader::getFloatArray( const std::string& keyword ) const
+{
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    return withStream( [&]( std::istream& stream )
+                       { return m_parser->parseFloatArray( m_tokens, stream, startIndex, arrayLength ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<double> Reader::getDoubleArray( const std::string& keyword ) const
+{
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    return withStream( [&]( std::istream& stream )
+                       { return m_parser->parseDoubleArray( m_tokens, stream, startIndex, arrayLength ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reads straight into the destination: a single read for binary files, decoding in place for ascii.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void Reader::readArray( const std::string& keyword, size_t offset, T* values, size_t count ) const
+{
+    auto it = m_arrays.find( keyword );
+    if ( it == m_arrays.end() ) throw std::runtime_error( "Missing array: " + keyword );
+
+    long startIndex  = it->second.startIndex;
+    long arrayLength = static_cast<long>( it->second.info.length );
+    if ( offset > static_cast<size_t>( arrayLength ) || count > static_cast<size_t>( arrayLength ) - offset )
+    {
+        throw std::runtime_error( "Array range out of bounds: " + keyword );
+    }
+
+    withStream( [&]( std::istream& stream )
+                { m_parser->readArray( m_tokens, stream, startIndex, arrayLength, offset, count, values ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+size_t Reader::readArray( const std::string& keyword, T* values, size_t capacity ) const
+{
+    size_t arrayLength = getArrayLength( keyword );
+    if ( arrayLength > capacity ) throw std::runtime_error( "Buffer too small for array: " + keyword );
+
+    readArray( keyword, 0, values, arrayLength );
+    return arrayLength;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t Reader::readIntArray( const std::string& keyword, int* values, size_t capacity ) const
+{
+    return readArray( keyword, values, capacity );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t Reader::readDoubleArray( const std::string& keyword, double* values, size_t capacity ) const
+{
+    return readArray( keyword, values, capacity );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t Reader::readFloatArray( const std::string& keyword, float* values, size_t capacity ) const
+{
+    return readArray( keyword, values, capacity );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t Reader::readByteArray( const std::string& keyword, char* values, size_t capacity ) const
+{
+    return readArray( keyword, values, capacity );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::readIntArray( const std::string& keyword, size_t offset, int* values, size_t count ) const
+{
+    readArray( keyword, offset, values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::readDoubleArray( const std::string& keyword, size_t offset, double* values, size_t count ) const
+{
+    readArray( keyword, offset, values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::readFloatArray( const std::string& keyword, size_t offset, float* values, size_t count ) const
+{
+    readArray( keyword, offset, values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Reader::readByteArray( const std::string& keyword, size_t offset, char* values, size_t count ) const
+{
+    readArray( keyword, offset, values, count );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Returns a view directly into the memory mapped file when the array is a binary blob that is
+/// suitably aligned for T. Otherwise the values are copied and the copy is owned by the view.
+/// Arrays of another type throw, so values are never reinterpreted as T.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+ArrayView<T> Reader::getArrayView( const std::string& keyword,
+                                  std::vector<T> ( Reader::*copyArray )( const std::string& ) const ) const
+{
+    if ( !hasArray( keyword ) ) return ArrayView<T>();
+    if ( !hasValueType<T>( arrayInfo( keyword ).kind ) )
+        throw std::runtime_error( "Unexpected type of array: " + keyword );
+
+    auto [startIndex, arrayLength] = arrayLocation( keyword );
+    bool isBlob = arrayLength > 0 && m_tokens.kind( startIndex ) == Token::Kind::ARRAYBLOB;
+    if ( m_mappedFile && m_isBinary && !m_swapBytes && isBlob )
+    {
+        Token       blob = m_tokens[startIndex];
+        const char* data = m_mappedFile->data() + blob.start();
+
+        bool isAligned       = reinterpret_cast<std::uintptr_t>( data ) % alignof( T ) == 0;
+        bool hasExpectedSize = blob.end() - blob.start() == static_cast<size_t>( arrayLength ) * sizeof( T );
+        if ( isAligned && hasExpectedSize && blob.end() <= m_mappedFile->size() )
+        {
+            return ArrayView<T>( reinterpret_cast<const T*>( data ), static_cast<size_t>( arrayLength ) );
+        }
+    }
+
+    return ArrayView<T>( std::make_shared<const std::vector<T>>( ( this->*copyArray )( keyword ) ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ArrayView<int> Reader::getIntArrayView( const std::string& keyword ) const
+{
+    return getArrayView<int>( keyword, &Reader::getIntArray );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ArrayView<double> Reader::getDoubleArrayView( const std::string& keyword ) const
 {
-    auto [startIndex, arrayLength] = m_arrayInfo[keyword];
-    return m_parser->parseStringArray( m_tokens, *m_stream, startIndex, arrayLength );
+    return getArrayView<double>( keyword, &Reader::getDoubleArray );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<int> Reader::getIntArray( const std::string& keyword )
+ArrayView<float> Reader::getFloatArrayView( const std::string& keyword ) const
 {
-    auto [startIndex, arrayLength] = m_arrayInfo[keyword];
-    return m_parser->parseIntArray( m_tokens, *m_stream, startIndex, arrayLength );
+    return getArrayView<float>( keyword, &Reader::getFloatArray );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<char> Reader::getByteArray( const std::string& keyword )
+ArrayView<char> Reader::getByteArrayView( const std::string& keyword ) const
 {
-    auto [startIndex, arrayLength] = m_arrayInfo[keyword];
-    return m_parser->parseByteArray( m_tokens, *m_stream, startIndex, arrayLength );
+    return getArrayView<char>( keyword, &Reader::getByteArray );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<float> Reader::getFloatArray( const std::string& keyword )
+void Reader::setThreadPool( ThreadPool& pool )
 {
-    auto [startIndex, arrayLength] = m_arrayInfo[keyword];
-    return m_parser->parseFloatArray( m_tokens, *m_stream, startIndex, arrayLength );
+    m_threadPool = &pool;
+    if ( m_parser ) m_parser->setThreadPool( pool );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Byte range [start, end) of the values of the array in the file.
+//--------------------------------------------------------------------------------------------------
+std::pair<size_t, size_t> Reader::arraySpan( long startIndex, long arrayLength ) const
+{
+    if ( arrayLength <= 0 ) return std::make_pair( size_t( 0 ), size_t( 0 ) );
+
+    bool isBlob    = m_tokens.kind( startIndex ) == Token::Kind::ARRAYBLOB;
+    long lastIndex = isBlob ? startIndex : startIndex + arrayLength - 1;
+    return std::make_pair( m_tokens.start( startIndex ), m_tokens.end( lastIndex ) );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-std::vector<double> Reader::getDoubleArray( const std::string& keyword )
+RoffArray Reader::parseArray( Token::Kind kind, long startIndex, long arrayLength, std::istream& stream ) const
 {
-    auto [startIndex, arrayLength] = m_arrayInfo[keyword];
-    return m_parser->parseDoubleArray( m_tokens, *m_stream, startIndex, arrayLength );
+    switch ( kind )
+    {
+        case Token::Kind::INT:
+            return m_parser->parseIntArray( m_tokens, stream, startIndex, arrayLength );
+        case Token::Kind::FLOAT:
+            return m_parser->parseFloatArray( m_tokens, stream, startIndex, arrayLength );
+        case Token::Kind::DOUBLE:
+            return m_parser->parseDoubleArray( m_tokens, stream, startIndex, arrayLength );
+        case Token::Kind::BOOL:
+        case Token::Kind::BYTE:
+            return m_parser->parseByteArray( m_tokens, stream, startIndex, arrayLength );
+        default:
+            return m_parser->parseStringArray( m_tokens, stream, startIndex, arrayLength );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Values of the array, from the memory mapped file or from the bytes read from the stream.
+//--------------------------------------------------------------------------------------------------
+RoffArray Reader::decodeArray( const ArrayRead& read ) const
+{
+    const char* bytes = m_mappedFile ? m_mappedFile->data() + read.start : read.bytes.data();
+
+    MemoryStreamBuffer buffer( bytes, read.end - read.start, read.start );
+    std::istream       stream( &buffer );
+    return parseArray( read.kind, read.startIndex, read.arrayLength, stream );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The bytes of the arrays are read from the stream in file order while the arrays already read are
+/// decoded on the thread pool. Reading waits when too many bytes are waiting to be decoded, and the
+/// bytes of an array are released as soon as it is decoded, so the raw bytes of all the arrays are
+/// not held at once. The calling thread decodes arrays when it cannot read.
+//--------------------------------------------------------------------------------------------------
+std::vector<RoffArray> Reader::readAndDecodeArrays( std::vector<ArrayRead>& reads ) const
+{
+    // A larger array is read when no other bytes are waiting.
+    constexpr size_t maxBytesInFlight = 64 * 1024 * 1024;
+
+    // Shared with the helper tasks, which may start after this call has returned. They then find no
+    // arrays left and never touch reads or arrays.
+    struct State
+    {
+        std::mutex              mutex;
+        std::condition_variable changed;
+        std::deque<size_t>      readIndices;
+        size_t                  numRead{ 0 };
+        size_t                  numDecoded{ 0 };
+        size_t                  numDecoding{ 0 };
+        size_t                  bytesInFlight{ 0 };
+        bool                    stop{ false };
+        std::exception_ptr      error;
+    };
+
+    auto                   state = std::make_shared<State>();
+    size_t                 count = reads.size();
+    std::vector<RoffArray> arrays( count );
+
+    // Decodes the next array that has been read. Called with the lock held.
+    auto decodeNext = [this, state, &reads, &arrays]( std::unique_lock<std::mutex>& lock )
+    {
+        size_t i = state->readIndices.front();
+        state->readIndices.pop_front();
+        state->numDecoding++;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            arrays[i] = decodeArray( reads[i] );
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+        std::string().swap( reads[i].bytes );
+
+        lock.lock();
+        state->numDecoding--;
+        state->numDecoded++;
+        state->bytesInFlight -= reads[i].end - reads[i].start;
+        if ( error && !state->error ) state->error = error;
+        if ( error ) state->stop = true;
+        state->changed.notify_all();
+    };
+
+    auto work = [state, count, decodeNext]()
+    {
+        std::unique_lock<std::mutex> lock( state->mutex );
+        while ( true )
+        {
+            state->changed.wait( lock,
+                                 [&state, count]()
+                                 { return state->stop || !state->readIndices.empty() || state->numRead == count; } );
+            if ( state->stop || state->readIndices.empty() ) return;
+
+            decodeNext( lock );
+        }
+    };
+
+    size_t numHelpers = std::min( count, m_threadPool->size() + 1 ) - 1;
+    for ( size_t i = 0; i < numHelpers; i++ )
+    {
+        m_threadPool->submit( work );
+    }
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+    while ( !state->stop && state->numDecoded < count )
+    {
+        size_t next     = state->numRead;
+        bool   canRead  = next < count;
+        size_t numBytes = canRead ? reads[next].end - reads[next].start : 0;
+        if ( canRead && state->bytesInFlight > 0 && state->bytesInFlight + numBytes > maxBytesInFlight )
+        {
+            canRead = false;
+        }
+
+        if ( canRead )
+        {
+            state->bytesInFlight += numBytes;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                ArrayRead& read = reads[next];
+                read.bytes.resize( numBytes );
+
+                std::lock_guard<std::mutex> streamLock( m_streamMutex );
+                m_stream->clear();
+                m_stream->seekg( read.start );
+                m_stream->read( read.bytes.data(), static_cast<std::streamsize>( numBytes ) );
+                if ( static_cast<size_t>( m_stream->gcount() ) != numBytes )
+                {
+                    throw std::runtime_error( "Unexpected end of stream." );
+                }
+            }
+            catch ( ... )
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if ( error )
+            {
+                if ( !state->error ) state->error = error;
+                state->stop = true;
+            }
+            else
+            {
+                state->numRead++;
+                state->readIndices.push_back( next );
+            }
+            state->changed.notify_all();
+        }
+        else if ( !state->readIndices.empty() )
+        {
+            decodeNext( lock );
+        }
+        else
+        {
+            state->changed.wait( lock );
+        }
+    }
+
+    // Helpers still decoding use reads and arrays.
+    state->changed.wait( lock, [&state]() { return state->numDecoding == 0; } );
+    if ( state->error ) std::rethrow_exception( state->error );
+
+    return arrays;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The arrays are read in file order and decoded in parallel. Memory mapped files are decoded in place,
+/// other streams are read while the arrays already read are decoded.
+//--------------------------------------------------------------------------------------------------
+std::map<std::string, RoffArray> Reader::getArrays( const std::vector<std::string>& keywords ) const
+{
+    std::vector<ArrayRead> reads;
+    for ( const auto& keyword : keywords )
+    {
+        auto it = m_arrays.find( keyword );
+        if ( it == m_arrays.end() ) throw std::runtime_error( "Missing array: " + keyword );
+
+        const ArrayEntry& entry       = it->second;
+        long              arrayLength = static_cast<long>( entry.info.length );
+        auto [start, end]             = arraySpan( entry.startIndex, arrayLength );
+        reads.push_back( { keyword, entry.info.kind, entry.startIndex, arrayLength, start, end, {} } );
+    }
+
+    std::sort( reads.begin(), reads.end(), []( const ArrayRead& a, const ArrayRead& b ) { return a.start < b.start; } );
+
+    std::vector<RoffArray> arrays;
+    if ( m_mappedFile )
+    {
+        arrays.resize( reads.size() );
+        m_threadPool->parallelFor( reads.size(), [&]( size_t i ) { arrays[i] = decodeArray( reads[i] ); } );
+    }
+    else
+    {
+        arrays = readAndDecodeArrays( reads );
+    }
+
+    std::map<std::string, RoffArray> values;
+    for ( size_t i = 0; i < reads.size(); i++ )
+    {
+        values[reads[i].keyword] = std::move( arrays[i] );
+    }
+
+    return values;
 }
@@ -18,44 +18,235 @@
 
 #pragma once
 
+#include "ArrayView.hpp"
+#include "MemoryMappedFile.hpp"
+#include "MemoryStreamBuffer.hpp"
+#include "ParseMode.hpp"
 #include "Parser.hpp"
+#include "RoffArray.hpp"
 #include "RoffScalar.hpp"
 #include "Token.hpp"
+#include "TokenStore.hpp"
+#include "Tokenizer.hpp"
 
 #include <istream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace roff
 {
+class ThreadPool;
+
+// Type and number of values of an array, and the position of the values in the file.
+struct ArrayInfo
+{
+    Token::Kind kind;
+    size_t      length;
+    size_t      offset;
+};
+
 class Reader
 {
 public:
     Reader( std::istream& stream );
+    explicit Reader( const std::string& fileName );
+
+    // Only keep the tag groups accepted by the filter (called with tag names and parameter names).
+    // The filedata tag is always kept. Must be set before parse().
+    void setTagFilter( TagFilter filter );
+    void setTagFilter( const std::vector<std::string>& names );
+
+    // Keep the parse results in a sidecar index file (<file>.roffidx). When the file has a valid index,
+    // parse() reads the index instead of tokenizing the file. Only used for readers created from a file
+    // name and without a tag filter.
+    void setUseIndexFile( bool useIndexFile );
+
+    void parse( ParseMode mode = ParseMode::FULL );
+
+    bool isMemoryMapped() const;
 
-    void parse();
+    // All scalars and arrays in file order.
+    const std::vector<std::pair<std::string, RoffScalar>>&  scalarNamedValues() const;
+    const std::vector<std::pair<std::string, Token::Kind>>& getNamedArrayTypes() const;
+    size_t                                                  getArrayLength( const std::string& keyword ) const;
 
-    std::vector<std::pair<std::string, RoffScalar>>  scalarNamedValues() const;
-    std::vector<std::pair<std::string, Token::Kind>> getNamedArrayTypes() const;
-    size_t                                           getArrayLength( const std::string& keyword ) const;
+    // Hashed lookups by name. Scalar names can occur more than once (e.g. parameter.name): the first
+    // value is returned. Missing names and scalars of another type throw std::runtime_error.
+    bool              hasScalar( const std::string& name ) const;
+    const RoffScalar& getScalar( const std::string& name ) const;
+    template <typename T>
+    const T& getScalar( const std::string& name ) const;
 
-    std::vector<std::string> getStringArray( const std::string& keyword );
-    std::vector<int>         getIntArray( const std::string& keyword );
-    std::vector<double>      getDoubleArray( const std::string& keyword );
-    std::vector<float>       getFloatArray( const std::string& keyword );
-    std::vector<char>        getByteArray( const std::string& keyword );
+    bool             hasArray( const std::string& keyword ) const;
+    const ArrayInfo& arrayInfo( const std::string& keyword ) const;
+
+    // After parse(), arrays can be read from several threads at the same time. Only reads from memory
+    // mapped files run concurrently. Reads from other streams (including files that cannot be mapped)
+    // are serialized on the stream.
+    std::vector<std::string> getStringArray( const std::string& keyword ) const;
+    std::vector<int>         getIntArray( const std::string& keyword ) const;
+    std::vector<double>      getDoubleArray( const std::string& keyword ) const;
+    std::vector<float>       getFloatArray( const std::string& keyword ) const;
+    std::vector<char>        getByteArray( const std::string& keyword ) const;
+
+    // Values of an array with the value type checked against the type of the array: int, float, double,
+    // char (byte and bool arrays) or std::string (char arrays). Throws if the array is missing or has
+    // another type.
+    template <typename T>
+    std::vector<T> getArray( const std::string& keyword ) const;
+
+    // Read all values of an array into a caller provided buffer, which must have room for at least
+    // getArrayLength( keyword ) values. Returns the number of values read.
+    size_t readIntArray( const std::string& keyword, int* values, size_t capacity ) const;
+    size_t readDoubleArray( const std::string& keyword, double* values, size_t capacity ) const;
+    size_t readFloatArray( const std::string& keyword, float* values, size_t capacity ) const;
+    size_t readByteArray( const std::string& keyword, char* values, size_t capacity ) const;
+
+    // Read the values [offset, offset + count) of an array into a caller provided buffer.
+    void readIntArray( const std::string& keyword, size_t offset, int* values, size_t count ) const;
+    void readDoubleArray( const std::string& keyword, size_t offset, double* values, size_t count ) const;
+    void readFloatArray( const std::string& keyword, size_t offset, float* values, size_t count ) const;
+    void readByteArray( const std::string& keyword, size_t offset, char* values, size_t count ) const;
+
+    ArrayView<int>    getIntArrayView( const std::string& keyword ) const;
+    ArrayView<double> getDoubleArrayView( const std::string& keyword ) const;
+    ArrayView<float>  getFloatArrayView( const std::string& keyword ) const;
+    ArrayView<char>   getByteArrayView( const std::string& keyword ) const;
+
+    // Read several arrays in one call. The values are read in file order and decoded in parallel on the
+    // thread pool. Throws if an array is missing.
+    std::map<std::string, RoffArray> getArrays( const std::vector<std::string>& keywords ) const;
+
+    // Pool used by getArrays and to decode large ASCII arrays, the global pool by default.
+    void setThreadPool( ThreadPool& pool );
 
 private:
-    void parseAscii();
-    void parseBinary();
-    bool detectFileTypeFromFirstToken( std::istream& stream );
+    struct ArrayEntry
+    {
+        ArrayInfo info;
+        long      startIndex;
+    };
+
+    // An array of getArrays. The bytes are only read for streams that are not memory mapped.
+    struct ArrayRead
+    {
+        std::string keyword;
+        Token::Kind kind;
+        long        startIndex;
+        long        arrayLength;
+        size_t      start;
+        size_t      end;
+        std::string bytes;
+    };
 
-    std::vector<Token>                               m_tokens;
+    void parseAscii( ParseMode mode );
+    void parseBinary( ParseMode mode );
+    bool readIndexFile( ParseMode mode );
+    void writeIndexFile( ParseMode mode ) const;
+
+    template <typename T>
+    size_t readArray( const std::string& keyword, T* values, size_t capacity ) const;
+    template <typename T>
+    void readArray( const std::string& keyword, size_t offset, T* values, size_t count ) const;
+
+    // True when the values of arrays of the kind have type T.
+    template <typename T>
+    static bool hasValueType( Token::Kind kind );
+
+    template <typename T>
+    ArrayView<T> getArrayView( const std::string& keyword,
+                               std::vector<T> ( Reader::*copyArray )( const std::string& ) const ) const;
+
+    void buildLookupTables( const std::vector<Token>&                                     tokens,
+                            const std::unordered_map<std::string, std::pair<long, long>>& arrayInfo );
+
+    std::pair<long, long>     arrayLocation( const std::string& keyword ) const;
+    std::pair<size_t, size_t> arraySpan( long startIndex, long arrayLength ) const;
+    RoffArray
+        parseArray( Token::Kind kind, long startIndex, long arrayLength, std::istream& stream ) const;
+    RoffArray              decodeArray( const ArrayRead& read ) const;
+    std::vector<RoffArray> readAndDecodeArrays( std::vector<ArrayRead>& reads ) const;
+
+    template <typename ReadFunction>
+    auto withStream( ReadFunction read ) const;
+
+    TokenStore                                       m_tokens;
+    std::unique_ptr<MemoryMappedFile>                m_mappedFile;
+    std::unique_ptr<MemoryStreamBuffer>              m_mappedBuffer;
+    std::unique_ptr<std::istream>                    m_ownedStream;
     std::istream*                                    m_stream;
+    std::string                                      m_fileName;
+    bool                                             m_useIndexFile;
+    bool                                             m_isBinary;
+    bool                                             m_swapBytes;
+    TagFilter                                        m_tagFilter;
     std::vector<std::pair<std::string, RoffScalar>>  m_scalarValues;
     std::vector<std::pair<std::string, Token::Kind>> m_arrayTypes;
-    std::map<std::string, std::pair<long, long>>     m_arrayInfo;
+    std::unordered_map<std::string, size_t>          m_scalarIndices;
+    std::unordered_map<std::string, ArrayEntry>      m_arrays;
     std::unique_ptr<Parser>                          m_parser;
+    mutable std::mutex                               m_streamMutex;
+    ThreadPool*                                      m_threadPool;
 };
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+const T& Reader::getScalar( const std::string& name ) const
+{
+    const T* value = std::get_if<T>( &getScalar( name ) );
+    if ( !value ) throw std::runtime_error( "Unexpected type of scalar: " + name );
+    return *value;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+std::vector<T> Reader::getArray( const std::string& keyword ) const
+{
+    static_assert( std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                       std::is_same_v<T, char> || std::is_same_v<T, std::string>,
+                   "Unsupported array value type." );
+
+    if ( !hasValueType<T>( arrayInfo( keyword ).kind ) )
+        throw std::runtime_error( "Unexpected type of array: " + keyword );
+
+    if constexpr ( std::is_same_v<T, int> )
+        return getIntArray( keyword );
+    else if constexpr ( std::is_same_v<T, float> )
+        return getFloatArray( keyword );
+    else if constexpr ( std::is_same_v<T, double> )
+        return getDoubleArray( keyword );
+    else if constexpr ( std::is_same_v<T, char> )
+        return getByteArray( keyword );
+    else
+        return getStringArray( keyword );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+bool Reader::hasValueType( Token::Kind kind )
+{
+    if constexpr ( std::is_same_v<T, int> )
+        return kind == Token::Kind::INT;
+    else if constexpr ( std::is_same_v<T, float> )
+        return kind == Token::Kind::FLOAT;
+    else if constexpr ( std::is_same_v<T, double> )
+        return kind == Token::Kind::DOUBLE;
+    else if constexpr ( std::is_same_v<T, char> )
+        return kind == Token::Kind::BYTE || kind == Token::Kind::BOOL;
+    else
+        return kind == Token::Kind::CHAR;
+}
 } // namespace roff
@@ -0,0 +1,362 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamReader.hpp"
+
+#include "AsciiArrayDecoder.hpp"
+#include "AsciiParser.hpp"
+#include "AsciiTokenizer.hpp"
+#include "BinaryParser.hpp"
+#include "BinaryTokenizer.hpp"
+#include "ByteSwap.hpp"
+#include "FileTypeDetector.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+StreamReader::StreamReader( std::istream& stream )
+    : m_source( stream )
+    , m_stream( nullptr )
+    , m_chunkSize( 65536 )
+    , m_isBinary( false )
+    , m_swapBytes( false )
+    , m_threadPool( &ThreadPool::globalInstance() )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+StreamReader::~StreamReader()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::setChunkSize( size_t numValues )
+{
+    m_chunkSize = std::max( numValues, size_t( 1 ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::setThreadPool( ThreadPool& pool )
+{
+    m_threadPool = &pool;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::read( EventHandler& handler )
+{
+    // All reading goes through the lookahead buffer, which also serves the seeks of the tokenizer
+    // and parser. Positions count from the current position of the source.
+    auto sourceStart = m_source.rdbuf()->pubseekoff( 0, std::ios_base::cur, std::ios_base::in );
+    m_buffer         = std::make_unique<LookaheadStreamBuffer>( *m_source.rdbuf() );
+    m_stream.rdbuf( m_buffer.get() );
+
+    FileType fileType = FileTypeDetector::detect( m_stream );
+    if ( fileType == FileType::UNKNOWN ) throw std::runtime_error( "Unexpected file type." );
+
+    m_isBinary = fileType == FileType::ROFF_BIN;
+
+    m_swapBytes = false;
+    if ( m_isBinary )
+    {
+        m_tokenizer = std::make_unique<BinaryTokenizer>();
+        m_parser    = std::make_unique<BinaryParser>();
+    }
+    else
+    {
+        m_tokenizer = std::make_unique<AsciiTokenizer>();
+        m_parser    = std::make_unique<AsciiParser>();
+    }
+
+    m_tokenizer->tokenizeFileType( m_stream );
+
+    while ( m_tokenizer->peekKeyword( m_stream ) == Token::Kind::TAG )
+    {
+        m_buffer->release( m_buffer->position() );
+        readTagGroup( handler );
+    }
+
+    // Leave seekable sources directly after the file, instead of after the bytes read ahead.
+    if ( sourceStart != std::streampos( -1 ) )
+    {
+        m_source.rdbuf()->pubseekpos( sourceStart + std::streamoff( m_buffer->position() ), std::ios_base::in );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::readTagGroup( EventHandler& handler )
+{
+    m_tokenizer->tokenizeKeyword( m_stream, Token::Kind::TAG );
+    std::string tagName = readString( m_tokenizer->tokenizeName( m_stream ) );
+    handler.onTagBegin( tagName );
+
+    m_buffer->release( m_buffer->position() );
+    auto keyword = m_tokenizer->tryTokenizeKeyword( m_stream );
+    while ( keyword && ( Token::isSimpleType( keyword->kind() ) || keyword->kind() == Token::Kind::ARRAY ) )
+    {
+        if ( keyword->kind() == Token::Kind::ARRAY )
+        {
+            readArray( handler, keyword.value() );
+        }
+        else
+        {
+            std::vector<Token> tokens = m_tokenizer->tokenizeTagKey( m_stream, keyword.value() );
+            std::string        name   = readString( tokens[1] );
+
+            // The byte order of binary files comes from the byteswaptest value of the filedata tag.
+            if ( m_isBinary && tagName == "filedata" && name == "byteswaptest" && tokens[0].kind() == Token::Kind::INT )
+            {
+                auto& tokenizer = static_cast<BinaryTokenizer&>( *m_tokenizer );
+                tokenizer.detectByteOrder( tokens[1], tokens[2], m_stream );
+                m_swapBytes = tokenizer.swapBytes();
+                m_parser    = std::make_unique<BinaryParser>( m_swapBytes );
+            }
+
+            handler.onScalar( name, readScalar( tokens[0].kind(), tokens[2] ) );
+        }
+
+        m_buffer->release( m_buffer->position() );
+        keyword = m_tokenizer->tryTokenizeKeyword( m_stream );
+    }
+
+    if ( !keyword || keyword->kind() != Token::Kind::ENDTAG ) throw std::runtime_error( "No matching keyword." );
+    handler.onTagEnd( tagName );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::readArray( EventHandler& handler, const Token& arrayToken )
+{
+    std::vector<Token> tokens = m_tokenizer->tokenizeArrayHeader( m_stream, arrayToken );
+    Token::Kind        kind   = tokens[1].kind();
+    std::string        name   = readString( tokens[2] );
+    int                length = std::get<int>( readScalar( Token::Kind::INT, tokens[3] ) );
+    if ( length < 0 ) throw std::runtime_error( "Invalid array length." );
+
+    handler.onArrayBegin( name, kind, static_cast<size_t>( length ) );
+
+    switch ( kind )
+    {
+        case Token::Kind::INT:
+            readValues<int>( name, static_cast<size_t>( length ), handler );
+            break;
+        case Token::Kind::FLOAT:
+            readValues<float>( name, static_cast<size_t>( length ), handler );
+            break;
+        case Token::Kind::DOUBLE:
+            readValues<double>( name, static_cast<size_t>( length ), handler );
+            break;
+        case Token::Kind::BOOL:
+        case Token::Kind::BYTE:
+            readValues<char>( name, static_cast<size_t>( length ), handler );
+            break;
+        default:
+            readStrings( name, static_cast<size_t>( length ), handler );
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void StreamReader::readValues( const std::string& name, size_t length, EventHandler& handler )
+{
+    if ( m_isBinary )
+        readBinaryValues<T>( name, length, handler );
+    else
+        readAsciiValues<T>( name, length, handler );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void StreamReader::readBinaryValues( const std::string& name, size_t length, EventHandler& handler )
+{
+    std::vector<T> values( std::min( m_chunkSize, length ) );
+
+    size_t offset = 0;
+    while ( offset < length )
+    {
+        size_t numValues = std::min( values.size(), length - offset );
+        auto   numBytes  = static_cast<std::streamsize>( numValues * sizeof( T ) );
+        m_stream.read( reinterpret_cast<char*>( values.data() ), numBytes );
+        if ( m_stream.gcount() != numBytes ) throw std::runtime_error( "Unexpected end of file." );
+        if ( m_swapBytes ) ByteSwap::swap( values.data(), numValues );
+
+        handler.onArrayChunk( name, ArrayView<T>( values.data(), numValues ), offset );
+        offset += numValues;
+        m_buffer->release( m_buffer->position() );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reads the text in blocks and decodes the complete values of each block, in parallel when the
+/// block is large. A value (or comment) cut by the end of a block is kept for the next block. Blocks
+/// are sized from the number of values left, so small arrays do not read far ahead.
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void StreamReader::readAsciiValues( const std::string& name, size_t length, EventHandler& handler )
+{
+    constexpr size_t minBlockSize  = 65536;
+    constexpr size_t maxBlockSize  = 4 * 1024 * 1024;
+    constexpr size_t bytesPerValue = 32;
+
+    std::vector<T> values( std::min( m_chunkSize, length ) );
+    std::string    buffer;
+    size_t         bufferStart = static_cast<size_t>( m_stream.tellg() );
+    size_t         pos         = 0;
+    size_t         numValues   = 0;
+    bool           isAtEnd     = false;
+
+    size_t offset = 0;
+    while ( offset < length )
+    {
+        size_t blockSize = std::clamp( ( length - offset ) * bytesPerValue, minBlockSize, maxBlockSize );
+        if ( !isAtEnd && ( numValues == 0 || buffer.size() - pos < blockSize / 2 ) )
+        {
+            buffer.erase( 0, pos );
+            bufferStart += pos;
+            pos = 0;
+            m_buffer->release( bufferStart );
+
+            size_t oldSize = buffer.size();
+            buffer.resize( oldSize + blockSize );
+            m_stream.read( buffer.data() + oldSize, static_cast<std::streamsize>( blockSize ) );
+            buffer.resize( oldSize + static_cast<size_t>( m_stream.gcount() ) );
+            isAtEnd = buffer.size() < oldSize + blockSize;
+        }
+
+        // Unless the stream has ended, the last value of the buffer may be incomplete.
+        size_t decodeEnd = buffer.size();
+        if ( !isAtEnd )
+        {
+            size_t lastSpace = buffer.find_last_of( " \t\n\r\v\f" );
+            decodeEnd        = ( lastSpace == std::string::npos || lastSpace < pos ) ? pos : lastSpace;
+        }
+
+        // Only pass on about the text of the values of this chunk, so the decoder does not count the
+        // values of the whole block for every chunk. Retry with the whole block if that has no values.
+        size_t count    = std::min( values.size(), length - offset );
+        size_t chunkEnd = decodeEnd;
+        if ( count * bytesPerValue < decodeEnd - pos )
+        {
+            chunkEnd = std::min( buffer.find_first_of( " \t\n\r\v\f", pos + count * bytesPerValue ), decodeEnd );
+        }
+
+        const char* valuesEnd = nullptr;
+
+        numValues = AsciiArrayDecoder::decode(
+            buffer.data() + pos, buffer.data() + chunkEnd, values.data(), count, *m_threadPool, &valuesEnd );
+        if ( numValues == 0 && chunkEnd != decodeEnd )
+        {
+            numValues = AsciiArrayDecoder::decode(
+                buffer.data() + pos, buffer.data() + decodeEnd, values.data(), count, *m_threadPool, &valuesEnd );
+        }
+        if ( numValues > 0 )
+        {
+            handler.onArrayChunk( name, ArrayView<T>( values.data(), numValues ), offset );
+            offset += numValues;
+            pos = static_cast<size_t>( valuesEnd - buffer.data() );
+        }
+        else if ( isAtEnd )
+        {
+            throw std::runtime_error( "Unexpected end of array." );
+        }
+    }
+
+    // Continue directly after the last value
+    m_stream.clear();
+    m_stream.seekg( static_cast<std::streamoff>( bufferStart + pos ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void StreamReader::readStrings( const std::string& name, size_t length, EventHandler& handler )
+{
+    std::vector<std::string> values;
+    values.reserve( std::min( m_chunkSize, length ) );
+
+    size_t offset = 0;
+    for ( size_t i = 0; i < length; i++ )
+    {
+        std::string value;
+        if ( m_isBinary )
+        {
+            std::getline( m_stream, value, '\0' );
+        }
+        else
+        {
+            m_tokenizer->tokenizeDelimiter( m_stream );
+            if ( m_stream.get() != '"' ) throw std::runtime_error( "Expected string." );
+            std::getline( m_stream, value, '"' );
+        }
+        if ( !m_stream ) throw std::runtime_error( "Unexpected end of file." );
+
+        values.push_back( std::move( value ) );
+        if ( values.size() == m_chunkSize )
+        {
+            handler.onArrayChunk( name, ArrayView<std::string>( values.data(), values.size() ), offset );
+            offset += values.size();
+            values.clear();
+            m_buffer->release( m_buffer->position() );
+        }
+    }
+
+    if ( !values.empty() ) handler.onArrayChunk( name, ArrayView<std::string>( values.data(), values.size() ), offset );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The parser reads values by seeking to the token: the stream position is restored afterwards. The
+/// token is after the last release, so the seeks stay within the lookahead buffer.
+//--------------------------------------------------------------------------------------------------
+RoffScalar StreamReader::readScalar( Token::Kind kind, const Token& token )
+{
+    auto       streamPos = m_stream.tellg();
+    RoffScalar value     = m_parser->parseScalar( kind, token, m_stream );
+    m_stream.clear();
+    m_stream.seekg( streamPos );
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::string StreamReader::readString( const Token& token )
+{
+    return std::get<std::string>( readScalar( Token::Kind::CHAR, token ) );
+}
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "EventHandler.hpp"
+#include "LookaheadStreamBuffer.hpp"
+#include "Parser.hpp"
+#include "Token.hpp"
+#include "Tokenizer.hpp"
+
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace roff
+{
+class ThreadPool;
+
+//==================================================================================================
+/// Walks a file once and reports its contents to an EventHandler. Array values are read and
+/// reported in chunks, so memory use does not depend on the size of the file. The input is read
+/// strictly forward through a lookahead buffer, so it does not need to be seekable (e.g. a pipe).
+//==================================================================================================
+class StreamReader
+{
+public:
+    explicit StreamReader( std::istream& stream );
+    ~StreamReader();
+
+    // Maximum number of values in each onArrayChunk call.
+    void setChunkSize( size_t numValues );
+
+    // Pool used for decoding large ASCII chunks, the global pool by default.
+    void setThreadPool( ThreadPool& pool );
+
+    void read( EventHandler& handler );
+
+private:
+    void readTagGroup( EventHandler& handler );
+    void readArray( EventHandler& handler, const Token& arrayToken );
+
+    template <typename T>
+    void readValues( const std::string& name, size_t length, EventHandler& handler );
+    template <typename T>
+    void readBinaryValues( const std::string& name, size_t length, EventHandler& handler );
+    template <typename T>
+    void readAsciiValues( const std::string& name, size_t length, EventHandler& handler );
+    void readStrings( const std::string& name, size_t length, EventHandler& handler );
+
+    RoffScalar  readScalar( Token::Kind kind, const Token& token );
+    std::string readString( const Token& token );
+
+    std::istream&                          m_source;
+    std::unique_ptr<LookaheadStreamBuffer> m_buffer;
+    std::istream                           m_stream;
+    size_t                                 m_chunkSize;
+    bool                                   m_isBinary;
+    bool                                   m_swapBytes;
+    std::unique_ptr<Tokenizer>             m_tokenizer;
+    std::unique_ptr<Parser>                m_parser;
+    ThreadPool*                            m_threadPool;
+};
+} // namespace roff
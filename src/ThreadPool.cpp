@@ -0,0 +1,176 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool( size_t numThreads )
+    : m_stop( false )
+    , m_numSubmittedTasks( 0 )
+{
+    if ( numThreads == 0 ) numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    for ( size_t i = 0; i < numThreads; i++ )
+    {
+        m_threads.emplace_back( &ThreadPool::workerLoop, this );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for ( std::thread& thread : m_threads )
+    {
+        thread.join();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t ThreadPool::size() const
+{
+    return m_threads.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t ThreadPool::numSubmittedTasks() const
+{
+    return m_numSubmittedTasks;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::future<void> ThreadPool::submit( std::function<void()> task )
+{
+    m_numSubmittedTasks++;
+
+    std::packaged_task<void()> packagedTask( std::move( task ) );
+    std::future<void>          future = packagedTask.get_future();
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_tasks.push( std::move( packagedTask ) );
+    }
+    m_condition.notify_one();
+
+    return future;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void ThreadPool::parallelFor( size_t count, const std::function<void( size_t )>& function )
+{
+    if ( count == 0 ) return;
+
+    // Shared with the helper tasks, which may start after this call has returned (when the work was
+    // already done by others). They then find no indices left and never touch function.
+    struct State
+    {
+        std::atomic<size_t>     nextIndex{ 0 };
+        size_t                  numDone{ 0 };
+        std::exception_ptr      error;
+        std::mutex              mutex;
+        std::condition_variable done;
+    };
+
+    auto state = std::make_shared<State>();
+
+    auto work = [state, count, &function]()
+    {
+        for ( size_t i = state->nextIndex++; i < count; i = state->nextIndex++ )
+        {
+            std::exception_ptr error;
+            try
+            {
+                function( i );
+            }
+            catch ( ... )
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock( state->mutex );
+            if ( error && !state->error ) state->error = error;
+            if ( ++state->numDone == count ) state->done.notify_all();
+        }
+    };
+
+    size_t numHelpers = std::min( count, size() + 1 ) - 1;
+    for ( size_t i = 0; i < numHelpers; i++ )
+    {
+        submit( work );
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+    state->done.wait( lock, [&state, count]() { return state->numDone == count; } );
+
+    if ( state->error ) std::rethrow_exception( state->error );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ThreadPool& ThreadPool::globalInstance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void ThreadPool::workerLoop()
+{
+    while ( true )
+    {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_condition.wait( lock, [this]() { return m_stop || !m_tasks.empty(); } );
+            if ( m_stop && m_tasks.empty() ) return;
+
+            task = std::move( m_tasks.front() );
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
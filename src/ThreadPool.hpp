@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Fixed size pool of worker threads.
+//==================================================================================================
+class ThreadPool
+{
+public:
+    // Zero threads means one per hardware thread.
+    explicit ThreadPool( size_t numThreads = 0 );
+    ~ThreadPool();
+
+    ThreadPool( const ThreadPool& )            = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    size_t size() const;
+
+    // Number of tasks submitted so far, including the helper tasks of parallelFor.
+    size_t numSubmittedTasks() const;
+
+    std::future<void> submit( std::function<void()> task );
+
+    // Calls function( i ) for i in [0, count) on the pool and waits for all calls to finish. The calling
+    // thread takes part in the work, so parallelFor can be called from inside a task of the same pool.
+    // The first exception thrown by function is rethrown.
+    void parallelFor( size_t count, const std::function<void( size_t )>& function );
+
+    // Shared pool used when no other pool is given.
+    static ThreadPool& globalInstance();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread>               m_threads;
+    std::queue<std::packaged_task<void()>> m_tasks;
+    std::mutex                             m_mutex;
+    std::condition_variable                m_condition;
+    bool                                   m_stop;
+    std::atomic<size_t>                    m_numSubmittedTasks;
+};
+} // namespace roff
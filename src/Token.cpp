@@ -103,6 +103,9 @@ std::string Token::kindToString( Token::Kind kind )
     return "";
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
 int Token::binaryTokenSizeInBytes( Kind kind )
 {
     switch ( kind )
@@ -123,3 +126,58 @@ int Token::binaryTokenSizeInBytes( Kind kind )
 
     return -1;
 }
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool Token::isSimpleType( Kind kind )
+{
+    return kind == Token::Kind::INT || kind == Token::Kind::BOOL || kind == Token::Kind::BYTE ||
+           kind == Token::Kind::FLOAT || kind == Token::Kind::DOUBLE || kind == Token::Kind::CHAR;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Classifies a word as a keyword with a switch on the first character, so that each word is
+/// compared against at most two keywords.
+//--------------------------------------------------------------------------------------------------
+std::optional<Token::Kind> Token::keywordKind( std::string_view word )
+{
+    if ( word.empty() ) return {};
+
+    switch ( word[0] )
+    {
+        case 'a':
+            if ( word == "array" ) return Token::Kind::ARRAY;
+            break;
+        case 'b':
+            if ( word == "bool" ) return Token::Kind::BOOL;
+            if ( word == "byte" ) return Token::Kind::BYTE;
+            break;
+        case 'c':
+            if ( word == "char" ) return Token::Kind::CHAR;
+            break;
+        case 'd':
+            if ( word == "double" ) return Token::Kind::DOUBLE;
+            break;
+        case 'e':
+            if ( word == "endtag" ) return Token::Kind::ENDTAG;
+            break;
+        case 'f':
+            if ( word == "float" ) return Token::Kind::FLOAT;
+            break;
+        case 'i':
+            if ( word == "int" ) return Token::Kind::INT;
+            break;
+        case 'r':
+            if ( word == "roff-bin" ) return Token::Kind::ROFF_BIN;
+            if ( word == "roff-asc" ) return Token::Kind::ROFF_ASC;
+            break;
+        case 't':
+            if ( word == "tag" ) return Token::Kind::TAG;
+            break;
+        default:
+            break;
+    }
+
+    return {};
+}
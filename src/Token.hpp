@@ -18,14 +18,17 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace roff
 {
 class Token
 {
 public:
-    enum class Kind
+    enum class Kind : uint8_t
     {
         ROFF_ASC,
         ROFF_BIN,
@@ -53,6 +56,9 @@ public:
 
     static std::string kindToString( Kind kind );
     static int         binaryTokenSizeInBytes( Kind kind );
+    static bool        isSimpleType( Kind kind );
+
+    static std::optional<Kind> keywordKind( std::string_view word );
 
 private:
     Kind   m_kind;
@@ -0,0 +1,147 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "TokenStore.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TokenStore::TokenStore()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void TokenStore::push_back( const Token& token )
+{
+    uint64_t start  = token.start();
+    uint64_t length = token.end() - token.start();
+    if ( start > maxOffset() || length > maxOffset() )
+    {
+        throw std::runtime_error( "Token offset out of range." );
+    }
+
+    m_kinds.push_back( token.kind() );
+    m_startLow.push_back( static_cast<uint32_t>( start ) );
+    m_startHigh.push_back( static_cast<uint16_t>( start >> 32 ) );
+    m_lengthLow.push_back( static_cast<uint32_t>( length ) );
+    m_lengthHigh.push_back( static_cast<uint16_t>( length >> 32 ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void TokenStore::reserve( size_t size )
+{
+    m_kinds.reserve( size );
+    m_startLow.reserve( size );
+    m_startHigh.reserve( size );
+    m_lengthLow.reserve( size );
+    m_lengthHigh.reserve( size );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void TokenStore::clear()
+{
+    m_kinds.clear();
+    m_startLow.clear();
+    m_startHigh.clear();
+    m_lengthLow.clear();
+    m_lengthHigh.clear();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void TokenStore::shrink_to_fit()
+{
+    m_kinds.shrink_to_fit();
+    m_startLow.shrink_to_fit();
+    m_startHigh.shrink_to_fit();
+    m_lengthLow.shrink_to_fit();
+    m_lengthHigh.shrink_to_fit();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t TokenStore::size() const
+{
+    return m_kinds.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool TokenStore::empty() const
+{
+    return m_kinds.empty();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Token TokenStore::operator[]( size_t index ) const
+{
+    return Token( kind( index ), start( index ), end( index ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Token::Kind TokenStore::kind( size_t index ) const
+{
+    assert( index < size() );
+    return m_kinds[index];
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t TokenStore::start( size_t index ) const
+{
+    assert( index < size() );
+    return static_cast<size_t>( uint64_t( m_startHigh[index] ) << 32 | m_startLow[index] );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t TokenStore::end( size_t index ) const
+{
+    assert( index < size() );
+    return start( index ) + static_cast<size_t>( uint64_t( m_lengthHigh[index] ) << 32 | m_lengthLow[index] );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t TokenStore::memoryUsage() const
+{
+    return m_kinds.capacity() * sizeof( Token::Kind ) + m_startLow.capacity() * sizeof( uint32_t ) +
+           m_startHigh.capacity() * sizeof( uint16_t ) + m_lengthLow.capacity() * sizeof( uint32_t ) +
+           m_lengthHigh.capacity() * sizeof( uint16_t );
+}
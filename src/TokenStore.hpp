@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Token.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Compact storage of tokens, laid out as structure of arrays: a one byte kind, and a 48 bit start
+/// offset and 48 bit length per token (13 bytes instead of the 24 bytes of a Token).
+//==================================================================================================
+class TokenStore
+{
+public:
+    TokenStore();
+
+    void push_back( const Token& token );
+    void reserve( size_t size );
+    void clear();
+    void shrink_to_fit();
+
+    size_t size() const;
+    bool   empty() const;
+
+    Token       operator[]( size_t index ) const;
+    Token::Kind kind( size_t index ) const;
+    size_t      start( size_t index ) const;
+    size_t      end( size_t index ) const;
+
+    // Bytes used by the stored tokens.
+    size_t memoryUsage() const;
+
+    // Offsets and lengths must be below 2^48 bytes.
+    static constexpr uint64_t maxOffset() { return ( uint64_t( 1 ) << 48 ) - 1; }
+
+private:
+    std::vector<Token::Kind> m_kinds;
+    std::vector<uint32_t>    m_startLow;
+    std::vector<uint16_t>    m_startHigh;
+    std::vector<uint32_t>    m_lengthLow;
+    std::vector<uint16_t>    m_lengthHigh;
+};
+} // namespace roff
@@ -18,8 +18,42 @@
 
 #include "Tokenizer.hpp"
 
+#include <cctype>
+#include <stdexcept>
+#include <string_view>
+
 using namespace roff;
 
+namespace
+{
+//==================================================================================================
+/// Restores the parse mode of a tokenizer when leaving the scope, also when an exception is thrown.
+//==================================================================================================
+class ParseModeGuard
+{
+public:
+    explicit ParseModeGuard( Tokenizer& tokenizer )
+        : m_tokenizer( tokenizer )
+        , m_parseMode( tokenizer.parseMode() )
+    {
+    }
+
+    ~ParseModeGuard() { m_tokenizer.setParseMode( m_parseMode ); }
+
+private:
+    Tokenizer& m_tokenizer;
+    ParseMode  m_parseMode;
+};
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Tokenizer::Tokenizer()
+    : m_parseMode( ParseMode::FULL )
+{
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -27,6 +61,53 @@ Tokenizer::~Tokenizer()
 {
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Tokenizer::setParseMode( ParseMode mode )
+{
+    m_parseMode = mode;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ParseMode Tokenizer::parseMode() const
+{
+    return m_parseMode;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Tokenizer::setTagFilter( TagFilter filter )
+{
+    m_tagFilter = std::move( filter );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Filters the tag group starting at groupStart in tokens, using the tag name and the first key.
+//--------------------------------------------------------------------------------------------------
+bool Tokenizer::isTagGroupIncluded( const std::vector<Token>&                         tokens,
+                                    size_t                                            groupStart,
+                                    const std::function<std::string( const Token& )>& tokenText ) const
+{
+    if ( !m_tagFilter ) return true;
+
+    std::string tagName = tokenText( tokens[groupStart + 1] );
+    if ( tagName == "filedata" ) return true;
+
+    // Parameters are filtered on the name of the parameter (char name "PORO").
+    bool hasFirstKey = tokens.size() >= groupStart + 5;
+    if ( tagName == "parameter" && hasFirstKey && tokens[groupStart + 2].kind() == Token::Kind::CHAR &&
+         tokenText( tokens[groupStart + 3] ) == "name" )
+    {
+        return m_tagFilter( tokenText( tokens[groupStart + 4] ) );
+    }
+
+    return m_tagFilter( tagName );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -62,22 +143,21 @@ bool Tokenizer::tokenizeComment( std::istream& stream )
 //--------------------------------------------------------------------------------------------------
 Token Tokenizer::tokenizeKeyword( std::istream& stream )
 {
-    std::vector<std::pair<Token::Kind, std::string>> keywords = {
-        std::make_pair( Token::Kind::ROFF_BIN, "roff-bin" ),
-        std::make_pair( Token::Kind::ROFF_ASC, "roff-asc" ),
-        std::make_pair( Token::Kind::TAG, "tag" ),
-        std::make_pair( Token::Kind::ENDTAG, "endtag" ),
-        std::make_pair( Token::Kind::CHAR, "char" ),
-        std::make_pair( Token::Kind::BOOL, "bool" ),
-        std::make_pair( Token::Kind::BYTE, "byte" ),
-        std::make_pair( Token::Kind::INT, "int" ),
-        std::make_pair( Token::Kind::FLOAT, "float" ),
-        std::make_pair( Token::Kind::DOUBLE, "double" ),
-        std::make_pair( Token::Kind::ARRAY, "array" ),
-    };
+    auto token = tryTokenizeKeyword( stream );
+    if ( !token ) throw std::runtime_error( "No matching keyword." );
 
-    tokenizeDelimiter( stream );
-    return tokenizeKeyword( stream, keywords );
+    return token.value();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Token Tokenizer::tokenizeKeyword( std::istream& stream, Token::Kind expectedKind )
+{
+    auto token = tryTokenizeKeyword( stream, expectedKind );
+    if ( !token ) throw std::runtime_error( "No matching keyword." );
+
+    return token.value();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -85,12 +165,12 @@ Token Tokenizer::tokenizeKeyword( std::istream& stream )
 //--------------------------------------------------------------------------------------------------
 Token Tokenizer::tokenizeFileType( std::istream& stream )
 {
-    std::vector<std::pair<Token::Kind, std::string>> keywords = {
-        std::make_pair( Token::Kind::ROFF_BIN, "roff-bin" ),
-        std::make_pair( Token::Kind::ROFF_ASC, "roff-asc" ),
-    };
+    auto token = tryTokenizeKeyword( stream );
+    if ( token && ( token->kind() == Token::Kind::ROFF_BIN || token->kind() == Token::Kind::ROFF_ASC ) )
+        return token.value();
 
-    return tokenizeKeyword( stream, keywords );
+    if ( token ) stream.seekg( token->start() );
+    throw std::runtime_error( "No matching keyword." );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -98,30 +178,71 @@ Token Tokenizer::tokenizeFileType( std::istream& stream )
 //--------------------------------------------------------------------------------------------------
 Token Tokenizer::tokenizeSimpleType( std::istream& stream )
 {
-    std::vector<std::pair<Token::Kind, std::string>> simpleTypes = { std::make_pair( Token::Kind::CHAR, "char" ),
-                                                                     std::make_pair( Token::Kind::BOOL, "bool" ),
-                                                                     std::make_pair( Token::Kind::BYTE, "byte" ),
-                                                                     std::make_pair( Token::Kind::INT, "int" ),
-                                                                     std::make_pair( Token::Kind::FLOAT, "float" ),
-                                                                     std::make_pair( Token::Kind::DOUBLE, "double" ) };
-    return tokenizeKeyword( stream, simpleTypes );
+    auto token = tryTokenizeKeyword( stream );
+    if ( token && Token::isSimpleType( token->kind() ) ) return token.value();
+
+    if ( token ) stream.seekg( token->start() );
+    throw std::runtime_error( "No matching keyword." );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reads the next word once and classifies it as a keyword. Returns nothing (with the stream
+/// position unchanged) when the word is not a keyword.
+//--------------------------------------------------------------------------------------------------
+std::optional<Token> Tokenizer::tryTokenizeKeyword( std::istream& stream )
+{
+    tokenizeDelimiter( stream );
+    auto start = stream.tellg();
+
+    // No keyword is longer than this, so a longer word can be rejected without reading all of it.
+    constexpr size_t maxKeywordLength = 8;
+
+    char   word[maxKeywordLength + 1];
+    size_t length = 0;
+    while ( length <= maxKeywordLength )
+    {
+        int c = stream.peek();
+        if ( c == std::char_traits<char>::eof() || c == '\0' || std::isspace( c ) ) break;
+
+        word[length++] = static_cast<char>( stream.get() );
+    }
+
+    auto kind = Token::keywordKind( std::string_view( word, length ) );
+    if ( !kind )
+    {
+        stream.clear();
+        stream.seekg( start );
+        return {};
+    }
+
+    return Token( kind.value(), static_cast<size_t>( start ), static_cast<size_t>( start ) + length );
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-Token Tokenizer::tokenizeKeyword( std::istream& stream, const std::vector<std::pair<Token::Kind, std::string>>& keywords )
+std::optional<Token> Tokenizer::tryTokenizeKeyword( std::istream& stream, Token::Kind expectedKind )
 {
-    for ( auto [kind, keyword] : keywords )
+    auto token = tryTokenizeKeyword( stream );
+    if ( token && token->kind() != expectedKind )
     {
-        auto token = tokenizeWord( stream, keyword, kind );
-        if ( token )
-        {
-            return token.value();
-        }
+        stream.seekg( token->start() );
+        return {};
     }
 
-    throw std::runtime_error( "No matching keyword." );
+    return token;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Look-ahead: kind of the next keyword in the stream without consuming it.
+//--------------------------------------------------------------------------------------------------
+std::optional<Token::Kind> Tokenizer::peekKeyword( std::istream& stream )
+{
+    auto token = tryTokenizeKeyword( stream );
+    if ( !token ) return {};
+
+    stream.seekg( token->start() );
+    return token->kind();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -141,28 +262,54 @@ std::vector<Token> Tokenizer::tokenizeTagGroup( std::istream& stream )
 {
     tokenizeDelimiter( stream );
     std::vector<Token> tokens;
-    tokens.push_back( tokenizeKeyword( stream, { std::make_pair( Token::Kind::TAG, "tag" ) } ) );
+    tokens.push_back( tokenizeKeyword( stream, Token::Kind::TAG ) );
     tokens.push_back( tokenizeName( stream ) );
 
-    bool hasMoreTokens = true;
-    while ( hasMoreTokens )
+    auto tokenText = [&stream]( const Token& token )
     {
-        try
-        {
-            std::vector<Token> tagGroupTokens = tokenizeTagKey( stream );
-
-            for ( const Token& tok : tagGroupTokens )
-                tokens.push_back( tok );
-
-            hasMoreTokens = true;
-        }
-        catch ( std::runtime_error& )
-        {
-            hasMoreTokens = false;
-        }
+        auto        streamPos = stream.tellg();
+        std::string text( token.end() - token.start(), '\0' );
+        stream.seekg( token.start() );
+        stream.read( text.data(), static_cast<std::streamsize>( text.size() ) );
+        stream.seekg( streamPos );
+        return text;
+    };
+
+    // The rest of a group that is filtered out is only skipped over, and its tokens are dropped.
+    std::optional<bool> isIncluded;
+    ParseModeGuard      parseModeGuard( *this );
+    auto                applyFilter = [&]()
+    {
+        isIncluded = isTagGroupIncluded( tokens, 0, tokenText );
+        if ( !isIncluded.value() ) m_parseMode = ParseMode::HEADER_ONLY;
+    };
+
+    // Parameters are filtered on their first key (the name of the parameter), other groups on the tag
+    // name. The filter is always applied before any array values are read.
+    if ( !m_tagFilter || tokenText( tokens[1] ) != "parameter" ) applyFilter();
+
+    // Keys continue until the next keyword is not a simple type or array (i.e. the end tag). Each
+    // keyword is read once and handed to the key.
+    auto keyword = tryTokenizeKeyword( stream );
+    while ( keyword && ( Token::isSimpleType( keyword->kind() ) || keyword->kind() == Token::Kind::ARRAY ) )
+    {
+        if ( !isIncluded && keyword->kind() == Token::Kind::ARRAY ) applyFilter();
+
+        std::vector<Token> tagGroupTokens = tokenizeTagKey( stream, keyword.value() );
+
+        for ( const Token& tok : tagGroupTokens )
+            tokens.push_back( tok );
+
+        if ( !isIncluded ) applyFilter();
+
+        keyword = tryTokenizeKeyword( stream );
     }
 
-    tokens.push_back( tokenizeKeyword( stream, { std::make_pair( Token::Kind::ENDTAG, "endtag" ) } ) );
+    if ( !keyword || keyword->kind() != Token::Kind::ENDTAG ) throw std::runtime_error( "No matching keyword." );
+    tokens.push_back( keyword.value() );
+
+    if ( !isIncluded ) applyFilter();
+    if ( !isIncluded.value() ) return {};
 
     return tokens;
 }
@@ -174,23 +321,14 @@ std::vector<Token> Tokenizer::tokenizeStream( std::istream& stream, Token::Kind
 {
     std::vector<Token> tokens;
 
-    tokens.push_back( tokenizeKeyword( stream, { std::make_pair( expectedKind, Token::kindToString( expectedKind ) ) } ) );
+    tokens.push_back( tokenizeKeyword( stream, expectedKind ) );
 
-    bool hasMoreTokens = true;
-    while ( hasMoreTokens )
+    // Tag groups continue until end of stream (or anything else than a tag)
+    while ( peekKeyword( stream ) == Token::Kind::TAG )
     {
-        try
-        {
-            std::vector<Token> tagGroupTokens = tokenizeTagGroup( stream );
-            for ( const Token& tok : tagGroupTokens )
-                tokens.push_back( tok );
-
-            hasMoreTokens = true;
-        }
-        catch ( std::runtime_error& )
-        {
-            hasMoreTokens = false;
-        }
+        std::vector<Token> tagGroupTokens = tokenizeTagGroup( stream );
+        for ( const Token& tok : tagGroupTokens )
+            tokens.push_back( tok );
     }
 
     return tokens;
@@ -201,12 +339,16 @@ std::vector<Token> Tokenizer::tokenizeStream( std::istream& stream, Token::Kind
 //--------------------------------------------------------------------------------------------------
 std::vector<Token> Tokenizer::tokenizeTagKey( std::istream& stream )
 {
-    try
-    {
-        return tokenizeTagKeyInternal( stream );
-    }
-    catch ( const std::runtime_error& )
-    {
-        return tokenizeArrayTagKey( stream );
-    }
+    return tokenizeTagKey( stream, tokenizeKeyword( stream ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The key starting with an already read keyword.
+//--------------------------------------------------------------------------------------------------
+std::vector<Token> Tokenizer::tokenizeTagKey( std::istream& stream, const Token& keyword )
+{
+    if ( keyword.kind() == Token::Kind::ARRAY ) return tokenizeArrayTagKey( stream, keyword );
+    if ( !Token::isSimpleType( keyword.kind() ) ) throw std::runtime_error( "Expected simple type." );
+
+    return tokenizeTagKeyInternal( stream, keyword );
 }
@@ -18,27 +18,42 @@
 
 #pragma once
 
+#include "ParseMode.hpp"
 #include "Token.hpp"
 
+#include <functional>
 #include <istream>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace roff
 {
+// Decides which tag groups to keep. Called with the tag name (or the parameter name for parameter tags).
+using TagFilter = std::function<bool( const std::string& name )>;
+
 class Tokenizer
 {
 public:
+    Tokenizer();
     virtual ~Tokenizer();
 
+    void      setParseMode( ParseMode mode );
+    ParseMode parseMode() const;
+
+    // Tag groups not accepted by the filter are skipped. The filedata tag is always kept.
+    void setTagFilter( TagFilter filter );
+
     virtual std::vector<Token>   tokenizeStream( std::istream& stream )                                             = 0;
     virtual bool                 tokenizeSpace( std::istream& stream )                                              = 0;
     virtual std::optional<Token> tokenizeString( std::istream& stream )                                             = 0;
     virtual Token                tokenizeName( std::istream& stream )                                               = 0;
-    virtual std::vector<Token>   tokenizeArrayTagKey( std::istream& stream )                                        = 0;
+    virtual std::vector<Token>   tokenizeArrayTagKey( std::istream& stream, const Token& arrayToken )               = 0;
+    virtual std::vector<Token>   tokenizeArrayHeader( std::istream& stream, const Token& arrayToken )               = 0;
     virtual std::optional<Token> tokenizeWord( std::istream& stream, const std::string& keywork, Token::Kind kind ) = 0;
 
     virtual std::vector<Token> tokenizeTagKey( std::istream& stream );
+    std::vector<Token>         tokenizeTagKey( std::istream& stream, const Token& keyword );
     std::vector<Token>         tokenizeStream( std::istream& stream, Token::Kind expectedKind );
     virtual std::vector<Token> tokenizeTagGroup( std::istream& stream );
     virtual bool               tokenizeComment( std::istream& stream );
@@ -46,9 +61,19 @@ public:
     virtual Token              tokenizeSimpleType( std::istream& stream );
     virtual Token              tokenizeKeyword( std::istream& stream );
     virtual Token              tokenizeFileType( std::istream& stream );
-    virtual Token tokenizeKeyword( std::istream& stream, const std::vector<std::pair<Token::Kind, std::string>>& keywords );
+    Token                      tokenizeKeyword( std::istream& stream, Token::Kind expectedKind );
+    std::optional<Token>       tryTokenizeKeyword( std::istream& stream );
+    std::optional<Token>       tryTokenizeKeyword( std::istream& stream, Token::Kind expectedKind );
+    std::optional<Token::Kind> peekKeyword( std::istream& stream );
 
 protected:
-    virtual std::vector<Token> tokenizeTagKeyInternal( std::istream& stream ) = 0;
+    virtual std::vector<Token> tokenizeTagKeyInternal( std::istream& stream, const Token& typeToken ) = 0;
+
+    bool isTagGroupIncluded( const std::vector<Token>&                         tokens,
+                             size_t                                            groupStart,
+                             const std::function<std::string( const Token& )>& tokenText ) const;
+
+    ParseMode m_parseMode;
+    TagFilter m_tagFilter;
 };
 } // namespace roff
@@ -0,0 +1,293 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Writer.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <variant>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Writer::Writer( std::ostream& stream )
+    : m_stream( stream )
+    , m_hasHeader( false )
+    , m_isFinished( false )
+    , m_isTagOpen( false )
+    , m_isArrayOpen( false )
+    , m_arrayKind( Token::Kind::INT )
+    , m_arrayLength( 0 )
+    , m_arrayWritten( 0 )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Writer::~Writer()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeHeader()
+{
+    if ( m_hasHeader ) throw std::runtime_error( "Header already written." );
+
+    writeFileType();
+    writeComment( "ROFF file" );
+    writeComment( "Creator: roffcpp" );
+    m_hasHeader = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeFileData( const std::string& fileType, const std::string& creationDate )
+{
+    beginTag( "filedata" );
+    writeScalar( "byteswaptest", 1 );
+    writeScalar( "filetype", fileType );
+    writeScalar( "creationDate", creationDate );
+    endTag();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::beginTag( const std::string& tagName )
+{
+    if ( !m_hasHeader || m_isFinished ) throw std::runtime_error( "Tag outside of file: " + tagName );
+    if ( m_isTagOpen ) throw std::runtime_error( "Nested tag: " + tagName );
+
+    writeTagBegin( tagName );
+    m_isTagOpen = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::endTag()
+{
+    checkTagIsOpen();
+
+    writeTagEnd();
+    m_isTagOpen = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeScalar( const std::string& name, const RoffScalar& value )
+{
+    checkTagIsOpen();
+
+    writeScalarValue( scalarKind( value ), name, value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const int* values, size_t count )
+{
+    beginArray( name, Token::Kind::INT, count );
+    appendArrayValues( values, count );
+    endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const float* values, size_t count )
+{
+    beginArray( name, Token::Kind::FLOAT, count );
+    appendArrayValues( values, count );
+    endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const double* values, size_t count )
+{
+    beginArray( name, Token::Kind::DOUBLE, count );
+    appendArrayValues( values, count );
+    endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const std::string* values, size_t count )
+{
+    beginArray( name, Token::Kind::CHAR, count );
+    appendArrayValues( values, count );
+    endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const std::vector<std::string>& values )
+{
+    writeArray( name, values.data(), values.size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::writeArray( const std::string& name, const char* values, size_t count, Token::Kind kind )
+{
+    beginArray( name, kind, count );
+    appendArrayValues( values, count );
+    endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::beginArray( const std::string& name, Token::Kind kind, size_t length )
+{
+    checkTagIsOpen();
+    if ( !Token::isSimpleType( kind ) ) throw std::runtime_error( "Unexpected array type: " + name );
+
+    // The length is stored as an int.
+    if ( length > static_cast<size_t>( std::numeric_limits<int>::max() ) )
+    {
+        throw std::runtime_error( "Array too long: " + name );
+    }
+
+    writeArrayBegin( kind, name, length );
+    m_isArrayOpen  = true;
+    m_arrayName    = name;
+    m_arrayKind    = kind;
+    m_arrayLength  = length;
+    m_arrayWritten = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void Writer::appendValues( const T* values, size_t count, bool hasExpectedKind )
+{
+    if ( !m_isArrayOpen ) throw std::runtime_error( "No array to append values to." );
+    if ( !hasExpectedKind ) throw std::runtime_error( "Unexpected value type for array: " + m_arrayName );
+    if ( count > m_arrayLength - m_arrayWritten )
+    {
+        throw std::runtime_error( "Too many values for array: " + m_arrayName );
+    }
+    if ( count == 0 ) return;
+
+    writeArrayValues( values, count );
+    m_arrayWritten += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::appendArrayValues( const int* values, size_t count )
+{
+    appendValues( values, count, m_arrayKind == Token::Kind::INT );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::appendArrayValues( const float* values, size_t count )
+{
+    appendValues( values, count, m_arrayKind == Token::Kind::FLOAT );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::appendArrayValues( const double* values, size_t count )
+{
+    appendValues( values, count, m_arrayKind == Token::Kind::DOUBLE );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::appendArrayValues( const char* values, size_t count )
+{
+    appendValues( values, count, m_arrayKind == Token::Kind::BYTE || m_arrayKind == Token::Kind::BOOL );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::appendArrayValues( const std::string* values, size_t count )
+{
+    appendValues( values, count, m_arrayKind == Token::Kind::CHAR );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::endArray()
+{
+    if ( !m_isArrayOpen ) throw std::runtime_error( "No array to end." );
+    if ( m_arrayWritten != m_arrayLength ) throw std::runtime_error( "Too few values for array: " + m_arrayName );
+
+    writeArrayEnd();
+    m_isArrayOpen = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void Writer::finish()
+{
+    if ( !m_hasHeader || m_isFinished ) throw std::runtime_error( "Unexpected end of file." );
+    if ( m_isTagOpen ) throw std::runtime_error( "Tag not ended before end of file." );
+
+    writeTagBegin( "eof" );
+    writeTagEnd();
+    m_isFinished = true;
+
+    m_stream.flush();
+    if ( !m_stream ) throw std::runtime_error( "Failed to write stream." );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Token::Kind Writer::scalarKind( const RoffScalar& value )
+{
+    if ( std::holds_alternative<int>( value ) ) return Token::Kind::INT;
+    if ( std::holds_alternative<float>( value ) ) return Token::Kind::FLOAT;
+    if ( std::holds_alternative<double>( value ) ) return Token::Kind::DOUBLE;
+    if ( std::holds_alternative<unsigned char>( value ) ) return Token::Kind::BYTE;
+    if ( std::holds_alternative<bool>( value ) ) return Token::Kind::BOOL;
+    return Token::Kind::CHAR;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Scalars and arrays are only written inside a tag, and not while an array is being written.
+//--------------------------------------------------------------------------------------------------
+void Writer::checkTagIsOpen() const
+{
+    if ( !m_isTagOpen ) throw std::runtime_error( "No open tag." );
+    if ( m_isArrayOpen ) throw std::runtime_error( "Array not ended: " + m_arrayName );
+}
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace roff
+{
+//==================================================================================================
+/// Writes ROFF files in file order: the header, then tag groups with scalars and arrays, and the eof
+/// tag from finish(). Array values are written straight to the stream, either from the caller's
+/// values in one call or appended chunk by chunk, so arrays are never buffered. The structure is
+/// checked, and misuse throws std::runtime_error.
+///
+/// The format is implemented by BinaryWriter and AsciiWriter.
+//==================================================================================================
+class Writer
+{
+public:
+    explicit Writer( std::ostream& stream );
+    virtual ~Writer();
+
+    // File type and header comments. Must be written first.
+    void writeHeader();
+
+    // The filedata tag, with byteswaptest for detecting the byte order when reading.
+    void writeFileData( const std::string& fileType, const std::string& creationDate );
+
+    void beginTag( const std::string& tagName );
+    void endTag();
+
+    // The kind of the scalar is given by the type of the value.
+    void writeScalar( const std::string& name, const RoffScalar& value );
+
+    void writeArray( const std::string& name, const int* values, size_t count );
+    void writeArray( const std::string& name, const float* values, size_t count );
+    void writeArray( const std::string& name, const double* values, size_t count );
+    void writeArray( const std::string& name, const std::string* values, size_t count );
+    void writeArray( const std::string& name, const std::vector<std::string>& values );
+
+    // Byte (or bool) arrays.
+    void writeArray( const std::string& name, const char* values, size_t count, Token::Kind kind = Token::Kind::BYTE );
+
+    // Arrays written in chunks: beginArray, then appendArrayValues until length values are written,
+    // then endArray.
+    void beginArray( const std::string& name, Token::Kind kind, size_t length );
+    void appendArrayValues( const int* values, size_t count );
+    void appendArrayValues( const float* values, size_t count );
+    void appendArrayValues( const double* values, size_t count );
+    void appendArrayValues( const char* values, size_t count );
+    void appendArrayValues( const std::string* values, size_t count );
+    void endArray();
+
+    // Writes the eof tag and flushes the stream.
+    void finish();
+
+protected:
+    virtual void writeFileType()                                                                        = 0;
+    virtual void writeComment( const std::string& comment )                                             = 0;
+    virtual void writeTagBegin( const std::string& tagName )                                            = 0;
+    virtual void writeTagEnd()                                                                          = 0;
+    virtual void writeScalarValue( Token::Kind kind, const std::string& name, const RoffScalar& value ) = 0;
+    virtual void writeArrayBegin( Token::Kind kind, const std::string& name, size_t length )            = 0;
+    virtual void writeArrayValues( const int* values, size_t count )                                    = 0;
+    virtual void writeArrayValues( const float* values, size_t count )                                  = 0;
+    virtual void writeArrayValues( const double* values, size_t count )                                 = 0;
+    virtual void writeArrayValues( const char* values, size_t count )                                   = 0;
+    virtual void writeArrayValues( const std::string* values, size_t count )                            = 0;
+    virtual void writeArrayEnd()                                                                        = 0;
+
+    std::ostream& m_stream;
+
+private:
+    template <typename T>
+    void appendValues( const T* values, size_t count, bool hasExpectedKind );
+
+    static Token::Kind scalarKind( const RoffScalar& value );
+
+    void checkTagIsOpen() const;
+
+    bool        m_hasHeader;
+    bool        m_isFinished;
+    bool        m_isTagOpen;
+    bool        m_isArrayOpen;
+    std::string m_arrayName;
+    Token::Kind m_arrayKind;
+    size_t      m_arrayLength;
+    size_t      m_arrayWritten;
+};
+} // namespace roff
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "WriterEventHandler.hpp"
+
+#include "Writer.hpp"
+
+#include <variant>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+WriterEventHandler::WriterEventHandler( Writer& writer )
+    : m_writer( writer )
+    , m_remainingValues( 0 )
+    , m_isFinished( false )
+{
+    m_writer.writeHeader();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The eof tag is written by Writer::finish().
+//--------------------------------------------------------------------------------------------------
+void WriterEventHandler::onTagBegin( const std::string& tagName )
+{
+    if ( tagName != "eof" ) m_writer.beginTag( tagName );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void WriterEventHandler::onScalar( const std::string& name, const RoffScalar& value )
+{
+    m_writer.writeScalar( name, value );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void WriterEventHandler::onArrayBegin( const std::string& name, Token::Kind kind, size_t length )
+{
+    m_writer.beginArray( name, kind, length );
+    m_remainingValues = length;
+    if ( m_remainingValues == 0 ) m_writer.endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void WriterEventHandler::onArrayChunk( const std::string& /*name*/, const ArrayChunk& values, size_t /*offset*/ )
+{
+    std::visit(
+        [this]( const auto& view )
+        {
+            m_writer.appendArrayValues( view.data(), view.size() );
+            m_remainingValues -= view.size();
+        },
+        values );
+
+    if ( m_remainingValues == 0 ) m_writer.endArray();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void WriterEventHandler::onTagEnd( const std::string& tagName )
+{
+    if ( tagName == "eof" )
+    {
+        m_writer.finish();
+        m_isFinished = true;
+    }
+    else
+    {
+        m_writer.endTag();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool WriterEventHandler::isFinished() const
+{
+    return m_isFinished;
+}
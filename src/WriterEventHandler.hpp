@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "EventHandler.hpp"
+#include "RoffScalar.hpp"
+#include "Token.hpp"
+
+#include <string>
+
+namespace roff
+{
+class Writer;
+
+//==================================================================================================
+/// Writes the contents reported by a StreamReader with a Writer, chunk by chunk. Used for converting
+/// between file formats without holding more than one chunk of an array in memory.
+//==================================================================================================
+class WriterEventHandler : public EventHandler
+{
+public:
+    // Writes the header of the new file.
+    explicit WriterEventHandler( Writer& writer );
+
+    void onTagBegin( const std::string& tagName ) override;
+    void onScalar( const std::string& name, const RoffScalar& value ) override;
+    void onArrayBegin( const std::string& name, Token::Kind kind, size_t length ) override;
+    void onArrayChunk( const std::string& name, const ArrayChunk& values, size_t offset ) override;
+    void onTagEnd( const std::string& tagName ) override;
+
+    // True when the eof tag has been written.
+    bool isFinished() const;
+
+private:
+    Writer& m_writer;
+    size_t  m_remainingValues;
+    bool    m_isFinished;
+};
+} // namespace roff
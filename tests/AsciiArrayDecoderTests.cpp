@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AsciiArrayDecoder.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, decodeInts )
+{
+    std::string text = "  1 -999\n  +42 #comment 7# 13\t0  ";
+
+    std::vector<int> values( 5 );
+    size_t           numValues = AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() );
+
+    ASSERT_EQ( 5u, numValues );
+    ASSERT_EQ( std::vector<int>( { 1, -999, 42, 13, 0 } ), values );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, decodeStopsAtCount )
+{
+    std::string text = "1 2 3 4";
+
+    std::vector<int> values( 2 );
+    ASSERT_EQ( 2u, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ) );
+    ASSERT_EQ( std::vector<int>( { 1, 2 } ), values );
+
+    std::vector<int> moreValues( 6 );
+    ASSERT_EQ( 4u, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), moreValues.data(), moreValues.size() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, skip )
+{
+    std::string text = " 1 #comment# 2\n3 4  ";
+    const char* end  = text.data() + text.size();
+
+    size_t numSkipped = 0;
+    ASSERT_EQ( text.data() + 14, AsciiArrayDecoder::skip( text.data(), end, 2, &numSkipped ) );
+    ASSERT_EQ( 2u, numSkipped );
+
+    ASSERT_EQ( text.data() + 18, AsciiArrayDecoder::skip( text.data(), end, 6, &numSkipped ) );
+    ASSERT_EQ( 4u, numSkipped );
+
+    ASSERT_EQ( text.data() + 18, AsciiArrayDecoder::skip( text.data() + 18, end, 1, &numSkipped ) );
+    ASSERT_EQ( 0u, numSkipped );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, decodeBytes )
+{
+    std::string text = "   0   1 255";
+
+    std::vector<char> values( 3 );
+    ASSERT_EQ( 3u, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ) );
+    ASSERT_EQ( 0, values[0] );
+    ASSERT_EQ( 1, values[1] );
+    ASSERT_EQ( static_cast<char>( 255 ), values[2] );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Values written with %.8E (as RMS does) must read back to the exact same float.
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, floatRoundTrip )
+{
+    std::vector<float> expected = { 0.0f, -1.0f, 1.0f / 3.0f, 461292.28125f, 5930999.0f, 1.17549435e-38f, 3.40282347e+38f, -2.5e-7f };
+
+    std::string text;
+    char        buffer[32];
+    for ( float value : expected )
+    {
+        std::snprintf( buffer, sizeof( buffer ), "  %.8E", static_cast<double>( value ) );
+        text += buffer;
+    }
+
+    std::vector<float> values( expected.size() );
+    ASSERT_EQ( expected.size(), AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ) );
+    ASSERT_EQ( expected, values );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, decodeDoubles )
+{
+    std::string text = "1.5E+03 -2.25 3 1e-300";
+
+    std::vector<double> values( 4 );
+    ASSERT_EQ( 4u, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ) );
+    ASSERT_EQ( std::vector<double>( { 1500.0, -2.25, 3.0, 1e-300 } ), values );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, parseScalars )
+{
+    std::string intText    = "12";
+    std::string doubleText = "1.000000000000000E+00";
+
+    ASSERT_EQ( 12, AsciiArrayDecoder::parseInt( intText.data(), intText.data() + intText.size() ) );
+    ASSERT_DOUBLE_EQ( 1.0, AsciiArrayDecoder::parseDouble( doubleText.data(), doubleText.data() + doubleText.size() ) );
+    ASSERT_FLOAT_EQ( 1.0f, AsciiArrayDecoder::parseFloat( doubleText.data(), doubleText.data() + doubleText.size() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, invalidValueThrows )
+{
+    std::string text = "1 2x 3";
+
+    std::vector<int> values( 3 );
+    ASSERT_THROW( AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ),
+                  std::runtime_error );
+
+    std::vector<float> floatValues( 3 );
+    ASSERT_THROW( AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), floatValues.data(), floatValues.size() ),
+                  std::runtime_error );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, outOfRangeValueThrows )
+{
+    std::vector<int> values( 1 );
+    for ( std::string text : { "3000000000", "-3000000000", "3.0E+09", "1.5E+00" } )
+    {
+        ASSERT_THROW( AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size() ),
+                      std::runtime_error )
+            << text;
+    }
+
+    std::string intText = "2.147483647E+09";
+    ASSERT_EQ( 1u, AsciiArrayDecoder::decode( intText.data(), intText.data() + intText.size(), values.data(), 1 ) );
+    ASSERT_EQ( 2147483647, values[0] );
+
+    std::vector<char> byteValues( 1 );
+    for ( std::string text : { "256", "300", "-1" } )
+    {
+        ASSERT_THROW(
+            AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), byteValues.data(), byteValues.size() ),
+            std::runtime_error )
+            << text;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiArrayDecoderTests, decodeParallel )
+{
+    // Large enough to be split in chunks (several MB of text)
+    size_t      count = 300000;
+    std::string text;
+    char        buffer[32];
+    for ( size_t i = 0; i < count; i++ )
+    {
+        std::snprintf( buffer, sizeof( buffer ), i % 4 == 3 ? " %16.8E\n" : " %16.8E", 0.1 * static_cast<double>( i ) );
+        text += buffer;
+    }
+
+    std::vector<float> expected( count );
+    ASSERT_EQ( count, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), expected.data(), expected.size() ) );
+
+    ThreadPool         pool( 4 );
+    std::vector<float> values( count );
+    ASSERT_EQ( count, AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), values.size(), pool ) );
+    ASSERT_EQ( expected, values );
+
+    // More values in the text than requested
+    std::vector<float> fewerValues( count / 2 );
+    ASSERT_EQ( fewerValues.size(),
+               AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), fewerValues.data(), fewerValues.size(), pool ) );
+    ASSERT_TRUE( std::equal( fewerValues.begin(), fewerValues.end(), expected.begin() ) );
+
+    // The end of the decoded values is the same as for sequential decoding
+    const char* expectedEnd = nullptr;
+    const char* valuesEnd   = nullptr;
+    AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), count / 2, &expectedEnd );
+    AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), count / 2, pool, &valuesEnd );
+    ASSERT_EQ( expectedEnd, valuesEnd );
+
+    AsciiArrayDecoder::decode( text.data(), text.data() + text.size(), values.data(), count, pool, &valuesEnd );
+    ASSERT_EQ( text.data() + text.size() - 1, valuesEnd );
+}
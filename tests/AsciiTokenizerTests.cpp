@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include <fstream>
+#include <sstream>
 #include <string>
 
 #include "AsciiTokenizer.hpp"
@@ -273,19 +274,33 @@ TEST( AsciiTokenizerTests, testTokenizeArrayTagKeyInt )
 {
     std::stringstream  stream( "array int my_array 6 1 2 3 4 5 6" );
     AsciiTokenizer     tokenizer;
-    std::vector<Token> tokens = tokenizer.tokenizeArrayTagKey( stream );
+    std::vector<Token> tokens = tokenizer.tokenizeTagKey( stream );
 
-    ASSERT_EQ( 10u, tokens.size() );
+    ASSERT_EQ( 5u, tokens.size() );
     ASSERT_EQ( Token::Kind::ARRAY, tokens[0].kind() );
     ASSERT_EQ( Token::Kind::INT, tokens[1].kind() );
     ASSERT_EQ( Token::Kind::NAME, tokens[2].kind() );
     ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[3].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[4].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[5].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[6].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[7].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[8].kind() );
-    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[9].kind() );
+
+    // All the values are covered by a single token
+    ASSERT_EQ( Token::Kind::ARRAYBLOB, tokens[4].kind() );
+    ASSERT_EQ( 21u, tokens[4].start() );
+    ASSERT_EQ( 32u, tokens[4].end() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeArrayTagKeyEmpty )
+{
+    std::stringstream  stream( "array float my_array 0 endtag" );
+    AsciiTokenizer     tokenizer;
+    std::vector<Token> tokens = tokenizer.tokenizeTagKey( stream );
+
+    ASSERT_EQ( 5u, tokens.size() );
+    ASSERT_EQ( Token::Kind::ARRAYBLOB, tokens[4].kind() );
+    ASSERT_EQ( tokens[4].start(), tokens[4].end() );
+    ASSERT_EQ( Token::Kind::ENDTAG, tokenizer.tokenizeKeyword( stream ).kind() );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -295,7 +310,7 @@ TEST( AsciiTokenizerTests, testTokenizeArrayTagKeyStrings )
 {
     std::stringstream  stream( "array char my_array 3 \"a\" \"bb\" \"ccc\"" );
     AsciiTokenizer     tokenizer;
-    std::vector<Token> tokens = tokenizer.tokenizeArrayTagKey( stream );
+    std::vector<Token> tokens = tokenizer.tokenizeTagKey( stream );
 
     ASSERT_EQ( 7u, tokens.size() );
     ASSERT_EQ( Token::Kind::ARRAY, tokens[0].kind() );
@@ -307,6 +322,75 @@ TEST( AsciiTokenizerTests, testTokenizeArrayTagKeyStrings )
     ASSERT_EQ( Token::Kind::STRING_LITERAL, tokens[6].kind() );
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeArrayTagKeyStringsHeaderOnly )
+{
+    std::string    content = "roff-asc tag t array char my_array 3 \"a\"  \"b b\" \"ccc\" endtag";
+    AsciiTokenizer tokenizer;
+    tokenizer.setParseMode( ParseMode::HEADER_ONLY );
+
+    std::stringstream  stream( content );
+    std::vector<Token> streamTokens = tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC );
+    std::vector<Token> bufferTokens = tokenizer.tokenizeBuffer( content.data(), content.size() );
+
+    for ( const auto& tokens : { streamTokens, bufferTokens } )
+    {
+        ASSERT_EQ( 9u, tokens.size() );
+        ASSERT_EQ( Token::Kind::ARRAYBLOB, tokens[7].kind() );
+        ASSERT_EQ( "\"a\"  \"b b\" \"ccc\"", content.substr( tokens[7].start(), tokens[7].end() - tokens[7].start() ) );
+        ASSERT_EQ( Token::Kind::ENDTAG, tokens[8].kind() );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeWithTagFilter )
+{
+    std::string content = "roff-asc tag a int x 1 endtag "
+                          "tag parameter char name \"P1\" array char names 1 \"skipped\" endtag "
+                          "tag parameter char name \"P2\" array int data 2 1 2 endtag "
+                          "tag b endtag";
+
+    AsciiTokenizer tokenizer;
+    tokenizer.setTagFilter( []( const std::string& name ) { return name == "a" || name == "P2"; } );
+
+    std::stringstream  stream( content );
+    std::vector<Token> streamTokens = tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC );
+    std::vector<Token> bufferTokens = tokenizer.tokenizeBuffer( content.data(), content.size() );
+
+    for ( const auto& tokens : { streamTokens, bufferTokens } )
+    {
+        // roff-asc + tag a (6 tokens) + parameter P2 (11 tokens)
+        ASSERT_EQ( 18u, tokens.size() );
+        ASSERT_EQ( "a", content.substr( tokens[2].start(), tokens[2].end() - tokens[2].start() ) );
+        ASSERT_EQ( "P2", content.substr( tokens[11].start(), tokens[11].end() - tokens[11].start() ) );
+        ASSERT_EQ( Token::Kind::ARRAYBLOB, tokens[16].kind() );
+        ASSERT_EQ( Token::Kind::ENDTAG, tokens[17].kind() );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Groups that are filtered out are skipped in header only mode. The parse mode must be restored when
+/// tokenizing fails.
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTagFilterRestoresParseMode )
+{
+    AsciiTokenizer tokenizer;
+    tokenizer.setTagFilter( []( const std::string& name ) { return name == "a"; } );
+
+    std::stringstream stream( "tag b array int data 2 1 2 int x endtag" );
+    ASSERT_THROW( tokenizer.tokenizeTagGroup( stream ), std::runtime_error );
+    ASSERT_EQ( ParseMode::FULL, tokenizer.parseMode() );
+
+    std::stringstream skippedStream( "tag b array char names 2 \"x\" \"y\" endtag tag a int x 1 endtag" );
+    ASSERT_TRUE( tokenizer.tokenizeTagGroup( skippedStream ).empty() );
+    ASSERT_EQ( ParseMode::FULL, tokenizer.parseMode() );
+    ASSERT_EQ( 6u, tokenizer.tokenizeTagGroup( skippedStream ).size() );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -317,7 +401,7 @@ TEST( AsciiTokenizerTests, testTokenizeExampleFile )
 
     AsciiTokenizer     tokenizer;
     std::vector<Token> tokens = tokenizer.tokenizeStream( stream );
-    ASSERT_EQ( 109u, tokens.size() );
+    ASSERT_EQ( 90u, tokens.size() );
 
     auto readValueForToken = []( std::istream& stream, const Token& token )
     {
@@ -335,4 +419,133 @@ TEST( AsciiTokenizerTests, testTokenizeExampleFile )
 
     ASSERT_EQ( "byteswaptest", readValueForToken( stream, tokens[4] ) );
     ASSERT_EQ( "codeNames", readValueForToken( stream, tokens[53] ) );
+
+    // Numeric array values are a single token
+    ASSERT_EQ( Token::Kind::ARRAYBLOB, tokens[70].kind() );
+    ASSERT_EQ( "-999         -999         -999         -999", readValueForToken( stream, tokens[70] ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testBufferTokensMatchStreamTokens )
+{
+    std::vector<std::string> fileNames = { "facies_info.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::ifstream stream( std::string( TEST_DATA_DIR ) + "/" + fileName, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+
+        AsciiTokenizer     tokenizer;
+        std::vector<Token> bufferTokens = tokenizer.tokenizeStream( stream );
+
+        // Character by character tokenization directly on the stream
+        stream.clear();
+        stream.seekg( 0 );
+        std::vector<Token> streamTokens = tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC );
+
+        ASSERT_EQ( streamTokens.size(), bufferTokens.size() );
+        for ( size_t i = 0; i < streamTokens.size(); i++ )
+        {
+            ASSERT_EQ( streamTokens[i].kind(), bufferTokens[i].kind() );
+            ASSERT_EQ( streamTokens[i].start(), bufferTokens[i].start() );
+            ASSERT_EQ( streamTokens[i].end(), bufferTokens[i].end() );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Tag groups read from a file stream one at a time, with windows too small for some of the groups.
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeTagGroupsFromFileStream )
+{
+    std::vector<std::string> fileNames = { "facies_info.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        for ( size_t windowSize : { 1, 100, 4096, 4 * 1024 * 1024 } )
+        {
+            std::ifstream stream( std::string( TEST_DATA_DIR ) + "/" + fileName, std::ios::binary );
+            ASSERT_TRUE( stream.good() );
+
+            AsciiTokenizer     tokenizer;
+            std::vector<Token> fileTokens = tokenizer.tokenizeStream( stream );
+
+            stream.clear();
+            stream.seekg( 0 );
+            tokenizer.setWindowSize( windowSize );
+            std::vector<Token> tagGroupTokens = tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC );
+
+            ASSERT_EQ( fileTokens.size(), tagGroupTokens.size() );
+            for ( size_t i = 0; i < fileTokens.size(); i++ )
+            {
+                ASSERT_EQ( fileTokens[i].kind(), tagGroupTokens[i].kind() );
+                ASSERT_EQ( fileTokens[i].start(), tagGroupTokens[i].start() );
+                ASSERT_EQ( fileTokens[i].end(), tagGroupTokens[i].end() );
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reading a stream tag group by tag group does not read the rest of the stream for every group.
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeTagGroupsReadsStreamOnce )
+{
+    // Counts the bytes read from the stream in blocks
+    class CountingBuffer : public std::stringbuf
+    {
+    public:
+        using std::stringbuf::stringbuf;
+        size_t numBytesRead = 0;
+
+    protected:
+        std::streamsize xsgetn( char* s, std::streamsize count ) override
+        {
+            std::streamsize numRead = std::stringbuf::xsgetn( s, count );
+            numBytesRead += static_cast<size_t>( numRead );
+            return numRead;
+        }
+    };
+
+    std::ifstream     file( std::string( TEST_DATA_DIR ) + "/reek_box_grid_w_props.roffasc", std::ios::binary );
+    std::stringstream content;
+    content << file.rdbuf();
+
+    CountingBuffer buffer( content.str() );
+    std::istream   stream( &buffer );
+
+    AsciiTokenizer tokenizer;
+    tokenizer.setWindowSize( 4096 );
+    ASSERT_FALSE( tokenizer.Tokenizer::tokenizeStream( stream, Token::Kind::ROFF_ASC ).empty() );
+    ASSERT_LT( buffer.numBytesRead, 3 * content.str().size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeBufferWithOffset )
+{
+    std::string    content = "roff-asc #comment# tag t int x 3 endtag";
+    AsciiTokenizer tokenizer;
+
+    std::vector<Token> tokens = tokenizer.tokenizeBuffer( content.data(), content.size(), 100u );
+    ASSERT_EQ( 7u, tokens.size() );
+    ASSERT_EQ( Token::Kind::ROFF_ASC, tokens[0].kind() );
+    ASSERT_EQ( 100u, tokens[0].start() );
+    ASSERT_EQ( Token::Kind::NUMERIC_VALUE, tokens[5].kind() );
+    ASSERT_EQ( 131u, tokens[5].start() );
+    ASSERT_EQ( 132u, tokens[5].end() );
+    ASSERT_EQ( Token::Kind::ENDTAG, tokens[6].kind() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( AsciiTokenizerTests, testTokenizeBufferWrongFileType )
+{
+    std::string    content = "roff-bin tag t int x 3 endtag";
+    AsciiTokenizer tokenizer;
+    ASSERT_THROW( tokenizer.tokenizeBuffer( content.data(), content.size() ), std::runtime_error );
 }
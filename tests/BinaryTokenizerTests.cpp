@@ -246,7 +246,7 @@ TEST( BinaryTokenizerTests, testTokenizeArrayBinaryTagKeyInt )
     stream.seekg( 0 );
 
     BinaryTokenizer    tokenizer;
-    std::vector<Token> tokens = tokenizer.tokenizeArrayTagKey( stream );
+    std::vector<Token> tokens = tokenizer.tokenizeTagKey( stream );
 
     ASSERT_EQ( 5, tokens.size() );
     ASSERT_EQ( Token::Kind::ARRAY, tokens[0].kind() );
@@ -334,3 +334,75 @@ TEST( BinaryTokenizerTests, testFileTypeDetectionEmptyStream )
     BinaryTokenizer   tokenizer;
     ASSERT_THROW( tokenizer.tokenizeFileType( stream ), std::runtime_error );
 }
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( BinaryTokenizerTests, testTokenizeStreamEndsAfterLastTagGroup )
+{
+    char bytes[] = { 'r', 'o', 'f', 'f', '-', 'b', 'i', 'n', '\0', 't', 'a',  'g',
+                     '\0', 'x', '\0', 'e', 'n', 'd', 't', 'a', 'g',  '\0', '\0' };
+    std::istringstream stream( std::string( std::begin( bytes ), std::end( bytes ) ) );
+
+    BinaryTokenizer    tokenizer;
+    std::vector<Token> tokens = tokenizer.tokenizeStream( stream );
+
+    ASSERT_EQ( 4u, tokens.size() );
+    ASSERT_EQ( Token::Kind::ROFF_BIN, tokens[0].kind() );
+    ASSERT_EQ( Token::Kind::TAG, tokens[1].kind() );
+    ASSERT_EQ( Token::Kind::NAME, tokens[2].kind() );
+    ASSERT_EQ( Token::Kind::ENDTAG, tokens[3].kind() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( BinaryTokenizerTests, testTokenizeTagGroupWithoutEndTag )
+{
+    char bytes[] = { 't', 'a', 'g', '\0', 'x', '\0', 'i', 'n', 't', '\0', 'b', '\0', '0', '1', '0', '0' };
+    std::istringstream stream( std::string( std::begin( bytes ), std::end( bytes ) ) );
+
+    BinaryTokenizer tokenizer;
+    ASSERT_THROW( tokenizer.tokenizeTagGroup( stream ), std::runtime_error );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( BinaryTokenizerTests, testPeekKeyword )
+{
+    char               bytes[] = { '\0', 'a', 'r', 'r', 'a', 'y', '\0', 'x', '\0' };
+    std::istringstream stream( std::string( std::begin( bytes ), std::end( bytes ) ) );
+
+    BinaryTokenizer tokenizer;
+    ASSERT_EQ( Token::Kind::ARRAY, tokenizer.peekKeyword( stream ) );
+    ASSERT_EQ( 1, stream.tellg() );
+
+    stream.seekg( 7 );
+    ASSERT_FALSE( tokenizer.peekKeyword( stream ).has_value() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Only the byteswaptest value of the filedata tag sets the byte order.
+//--------------------------------------------------------------------------------------------------
+TEST( BinaryTokenizerTests, testByteOrderFromFileData )
+{
+    using namespace std::string_literals;
+
+    std::string otherTag = "tag\0other\0int\0byteswaptest\0\0\0\0\1endtag\0"s;
+    std::string fileData = "tag\0filedata\0int\0byteswaptest\0\0\0\0\1endtag\0"s;
+
+    {
+        std::istringstream stream( otherTag );
+        BinaryTokenizer    tokenizer;
+        ASSERT_EQ( 6u, tokenizer.tokenizeTagGroup( stream ).size() );
+        ASSERT_FALSE( tokenizer.swapBytes() );
+    }
+
+    {
+        std::istringstream stream( fileData );
+        BinaryTokenizer    tokenizer;
+        ASSERT_EQ( 6u, tokenizer.tokenizeTagGroup( stream ).size() );
+        ASSERT_TRUE( tokenizer.swapBytes() );
+    }
+}
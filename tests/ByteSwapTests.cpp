@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "ByteSwap.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ByteSwapTests, swappedScalars )
+{
+    ASSERT_EQ( 1, ByteSwap::swapped( 0x01000000 ) );
+    ASSERT_EQ( 0x04030201, ByteSwap::swapped( 0x01020304 ) );
+    ASSERT_EQ( 1.5f, ByteSwap::swapped( ByteSwap::swapped( 1.5f ) ) );
+    ASSERT_EQ( -2.25, ByteSwap::swapped( ByteSwap::swapped( -2.25 ) ) );
+
+    float         value = ByteSwap::swapped( 1.0f ); // 0x3F800000
+    unsigned char bytes[4];
+    std::memcpy( bytes, &value, sizeof( value ) );
+    ASSERT_EQ( 0x3F, bytes[0] );
+    ASSERT_EQ( 0x80, bytes[1] );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// All lengths around the vector width, also when the values are not aligned.
+//--------------------------------------------------------------------------------------------------
+TEST( ByteSwapTests, swapArrays )
+{
+    for ( size_t count = 0; count < 40; count++ )
+    {
+        for ( size_t offset = 0; offset < 3; offset++ )
+        {
+            std::vector<int> ints( count + offset );
+            for ( size_t i = 0; i < ints.size(); i++ )
+                ints[i] = static_cast<int>( i * 0x01020304 );
+            std::vector<int> expectedInts = ints;
+            for ( size_t i = offset; i < expectedInts.size(); i++ )
+                expectedInts[i] = ByteSwap::swapped( expectedInts[i] );
+
+            ByteSwap::swap( ints.data() + offset, count );
+            ASSERT_EQ( expectedInts, ints );
+
+            // Doubles starting at an odd address
+            std::vector<char> buffer( 1 + ( count + offset ) * sizeof( double ) );
+            for ( size_t i = 0; i < buffer.size(); i++ )
+                buffer[i] = static_cast<char>( i );
+            std::vector<char> expectedBuffer = buffer;
+            for ( size_t i = 0; i < count; i++ )
+            {
+                char* value = expectedBuffer.data() + 1 + ( offset + i ) * sizeof( double );
+                for ( size_t j = 0; j < sizeof( double ) / 2; j++ )
+                    std::swap( value[j], value[sizeof( double ) - 1 - j] );
+            }
+
+            ByteSwap::swap( reinterpret_cast<double*>( buffer.data() + 1 + offset * sizeof( double ) ), count );
+            ASSERT_EQ( expectedBuffer, buffer );
+        }
+    }
+}
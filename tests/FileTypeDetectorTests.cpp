@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "FileTypeDetector.hpp"
+
+#include "RoffTestDataDirectory.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+/// Stream buffer without seeking, like a pipe.
+//--------------------------------------------------------------------------------------------------
+class NonSeekableBuffer : public std::streambuf
+{
+public:
+    explicit NonSeekableBuffer( std::string data )
+        : m_data( std::move( data ) )
+    {
+        setg( m_data.data(), m_data.data(), m_data.data() + m_data.size() );
+    }
+
+private:
+    std::string m_data;
+};
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( FileTypeDetectorTests, detectFromBytes )
+{
+    auto detect = []( const std::string& text ) { return FileTypeDetector::detect( text.data(), text.size() ); };
+
+    ASSERT_EQ( FileType::ROFF_BIN, detect( std::string( "roff-bin\0#ROFF file#", 20 ) ) );
+    ASSERT_EQ( FileType::ROFF_ASC, detect( "roff-asc \n#ROFF file#" ) );
+    ASSERT_EQ( FileType::ROFF_ASC, detect( "  \nroff-asc\n" ) );
+    ASSERT_EQ( FileType::ROFF_ASC, detect( "roff-asc" ) );
+
+    ASSERT_EQ( FileType::UNKNOWN, detect( "" ) );
+    ASSERT_EQ( FileType::UNKNOWN, detect( "roff-as" ) );
+    ASSERT_EQ( FileType::UNKNOWN, detect( "roff-ascii" ) );
+    ASSERT_EQ( FileType::UNKNOWN, detect( "unsupported-roff-header" ) );
+    ASSERT_EQ( FileType::UNKNOWN, detect( "ROFF-BIN" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( FileTypeDetectorTests, detectFiles )
+{
+    std::vector<std::pair<std::string, FileType>> fileTypes = {
+        { "facies_info.roff", FileType::ROFF_ASC },
+        { "facies_info.roffbin", FileType::ROFF_BIN },
+        { "facies_info_bigendian.roffbin", FileType::ROFF_BIN },
+        { "reek_box_grid_w_props.roff", FileType::ROFF_BIN },
+        { "reek_box_grid_w_props.roffasc", FileType::ROFF_ASC },
+        { "unexpected_filetype.roff", FileType::UNKNOWN },
+        { "does_not_exist.roff", FileType::UNKNOWN } };
+
+    for ( auto [fileName, fileType] : fileTypes )
+    {
+        ASSERT_EQ( fileType, FileTypeDetector::detect( std::string( TEST_DATA_DIR ) + "/" + fileName ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( FileTypeDetectorTests, streamIsNotConsumed )
+{
+    std::string fileName = std::string( TEST_DATA_DIR ) + "/facies_info.roffbin";
+
+    std::ifstream stream( fileName, std::ios::binary );
+    ASSERT_EQ( FileType::ROFF_BIN, FileTypeDetector::detect( stream ) );
+    ASSERT_TRUE( stream.good() );
+    ASSERT_EQ( 0, stream.tellg() );
+
+    std::string data( ( std::istreambuf_iterator<char>( stream ) ), std::istreambuf_iterator<char>() );
+
+    NonSeekableBuffer buffer( data );
+    std::istream      nonSeekableStream( &buffer );
+    ASSERT_EQ( FileType::ROFF_BIN, FileTypeDetector::detect( nonSeekableStream ) );
+    ASSERT_TRUE( nonSeekableStream.good() );
+
+    std::string readData( ( std::istreambuf_iterator<char>( nonSeekableStream ) ), std::istreambuf_iterator<char>() );
+    ASSERT_EQ( data, readData );
+
+    std::istringstream shortStream( "roff" );
+    ASSERT_EQ( FileType::UNKNOWN, FileTypeDetector::detect( shortStream ) );
+    ASSERT_EQ( 'r', shortStream.peek() );
+}
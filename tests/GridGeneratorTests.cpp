@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AsciiWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "GridGenerator.hpp"
+#include "Reader.hpp"
+#include "RoffTestDataDirectory.hpp"
+
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename WriterType>
+std::string generate( const GridGeneratorOptions& options )
+{
+    std::stringstream stream;
+    WriterType        writer( stream );
+    GridGenerator::write( writer, options );
+    return stream.str();
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, readGeneratedGrid )
+{
+    GridGeneratorOptions options;
+    options.nX              = 4;
+    options.nY              = 3;
+    options.nZ              = 2;
+    options.floatParameters = { "PORO", "PERMX" };
+    options.intParameters   = { "FACIES" };
+    options.numCodes        = 3;
+
+    std::stringstream stream( generate<BinaryWriter>( options ) );
+    Reader            reader( stream );
+    reader.parse();
+
+    ASSERT_EQ( 4, reader.getScalar<int>( "dimensions.nX" ) );
+    ASSERT_EQ( 3, reader.getScalar<int>( "dimensions.nY" ) );
+    ASSERT_EQ( 2, reader.getScalar<int>( "dimensions.nZ" ) );
+
+    size_t numCells = 4 * 3 * 2;
+    size_t numNodes = 5 * 4 * 3;
+    ASSERT_EQ( 6u * 5 * 4, reader.getArrayLength( "cornerLines.data" ) );
+
+    // The nodes of the fault plane at i = 2 are split in four.
+    std::vector<char> splitEnz = reader.getByteArray( "zvalues.splitEnz" );
+    ASSERT_EQ( numNodes, splitEnz.size() );
+    size_t numZValues = std::accumulate( splitEnz.begin(), splitEnz.end(), size_t( 0 ) );
+    ASSERT_EQ( numNodes + 3 * 4 * 3, numZValues );
+    ASSERT_EQ( numZValues, reader.getArrayLength( "zvalues.data" ) );
+
+    std::vector<char> active = reader.getByteArray( "active.data" );
+    ASSERT_EQ( numCells, active.size() );
+    for ( char value : active )
+    {
+        ASSERT_TRUE( value == 0 || value == 1 );
+    }
+
+    for ( const std::string name : { "PORO", "PERMX" } )
+    {
+        std::vector<float> values = reader.getFloatArray( name );
+        ASSERT_EQ( numCells, values.size() );
+        for ( float value : values )
+        {
+            ASSERT_GE( value, 0.05f );
+            ASSERT_LE( value, 0.35f );
+        }
+    }
+    ASSERT_NE( reader.getFloatArray( "PORO" ), reader.getFloatArray( "PERMX" ) );
+
+    std::vector<std::string> expectedCodeNames = { "Code 1", "Code 2", "Code 3" };
+    std::vector<int>         expectedCodes     = { 1, 2, 3 };
+    ASSERT_EQ( expectedCodeNames, reader.getStringArray( "FACIES.codeNames" ) );
+    ASSERT_EQ( expectedCodes, reader.getIntArray( "FACIES.codeValues" ) );
+    std::vector<int> facies = reader.getIntArray( "FACIES" );
+    ASSERT_EQ( numCells, facies.size() );
+    for ( int value : facies )
+    {
+        ASSERT_TRUE( value >= 1 && value <= 3 );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The split nodes on the fault have their values in the order sw, se, nw, ne: the columns east of
+/// the fault (se, ne) are thrown down, like all the nodes east of it.
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, faultZValues )
+{
+    GridGeneratorOptions options;
+    options.nX = 4;
+    options.nY = 3;
+    options.nZ = 2;
+
+    std::stringstream stream( generate<BinaryWriter>( options ) );
+    Reader            reader( stream );
+    reader.parse();
+
+    std::vector<char>  splitEnz = reader.getByteArray( "zvalues.splitEnz" );
+    std::vector<float> zvalues  = reader.getFloatArray( "zvalues.data" );
+
+    const int   faultI     = 2;
+    const float faultThrow = 15.0f;
+
+    size_t node  = 0;
+    size_t index = 0;
+    for ( int i = 0; i <= options.nX; i++ )
+    {
+        for ( int j = 0; j <= options.nY; j++ )
+        {
+            for ( int k = 0; k <= options.nZ; k++ )
+            {
+                float z = -( 1600.0f + 0.5f * i + 0.25f * j + 2.0f * ( options.nZ - k ) );
+                if ( i == faultI )
+                {
+                    ASSERT_EQ( 4, splitEnz[node] );
+                    ASSERT_FLOAT_EQ( z, zvalues[index] );
+                    ASSERT_FLOAT_EQ( z - faultThrow, zvalues[index + 1] );
+                    ASSERT_FLOAT_EQ( z, zvalues[index + 2] );
+                    ASSERT_FLOAT_EQ( z - faultThrow, zvalues[index + 3] );
+                }
+                else
+                {
+                    ASSERT_EQ( 1, splitEnz[node] );
+                    ASSERT_FLOAT_EQ( i > faultI ? z - faultThrow : z, zvalues[index] );
+                }
+
+                index += static_cast<size_t>( splitEnz[node] );
+                node++;
+            }
+        }
+    }
+    ASSERT_EQ( zvalues.size(), index );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, deterministic )
+{
+    GridGeneratorOptions options;
+    options.nX = 7;
+    options.nY = 5;
+    options.nZ = 3;
+
+    ASSERT_EQ( generate<BinaryWriter>( options ), generate<BinaryWriter>( options ) );
+    ASSERT_EQ( generate<AsciiWriter>( options ), generate<AsciiWriter>( options ) );
+
+    // Values depend on the seed.
+    GridGeneratorOptions otherOptions = options;
+    otherOptions.seed                 = 1;
+    ASSERT_NE( generate<BinaryWriter>( options ), generate<BinaryWriter>( otherOptions ) );
+
+    // The values of an array do not depend on the other parameters.
+    otherOptions                 = options;
+    otherOptions.floatParameters = { "PERMX", "PORO" };
+
+    std::stringstream stream( generate<BinaryWriter>( options ) );
+    std::stringstream otherStream( generate<BinaryWriter>( otherOptions ) );
+    Reader            reader( stream );
+    Reader            otherReader( otherStream );
+    reader.parse();
+    otherReader.parse();
+    ASSERT_EQ( reader.getFloatArray( "PORO" ), otherReader.getFloatArray( "PORO" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, binaryAndAsciiMatch )
+{
+    GridGeneratorOptions options;
+    options.nX            = 6;
+    options.nY            = 4;
+    options.nZ            = 5;
+    options.intParameters = { "EQLNUM", "FIPNUM" };
+
+    std::stringstream binaryStream( generate<BinaryWriter>( options ) );
+    std::stringstream asciiStream( generate<AsciiWriter>( options ) );
+    Reader            binaryReader( binaryStream );
+    Reader            asciiReader( asciiStream );
+    binaryReader.parse();
+    asciiReader.parse();
+
+    ASSERT_EQ( binaryReader.scalarNamedValues(), asciiReader.scalarNamedValues() );
+    ASSERT_EQ( binaryReader.getNamedArrayTypes(), asciiReader.getNamedArrayTypes() );
+    ASSERT_EQ( binaryReader.getFloatArray( "cornerLines.data" ), asciiReader.getFloatArray( "cornerLines.data" ) );
+    ASSERT_EQ( binaryReader.getFloatArray( "zvalues.data" ), asciiReader.getFloatArray( "zvalues.data" ) );
+    ASSERT_EQ( binaryReader.getByteArray( "active.data" ), asciiReader.getByteArray( "active.data" ) );
+    ASSERT_EQ( binaryReader.getFloatArray( "PORO" ), asciiReader.getFloatArray( "PORO" ) );
+    ASSERT_EQ( binaryReader.getIntArray( "FIPNUM" ), asciiReader.getIntArray( "FIPNUM" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, mirrorsRmsGridStructure )
+{
+    Reader expectedReader( std::string( TEST_DATA_DIR ) + "/reek_box_grid_w_props.roff" );
+    expectedReader.parse( ParseMode::HEADER_ONLY );
+
+    GridGeneratorOptions options;
+    options.nX            = 21;
+    options.nY            = 23;
+    options.nZ            = 14;
+    options.intParameters = { "EQLNUM", "FIPNUM" };
+
+    std::stringstream stream( generate<BinaryWriter>( options ) );
+    Reader            reader( stream );
+    reader.parse( ParseMode::HEADER_ONLY );
+
+    auto expectedScalars = expectedReader.scalarNamedValues();
+    auto scalars         = reader.scalarNamedValues();
+    ASSERT_EQ( expectedScalars.size(), scalars.size() );
+    for ( size_t i = 0; i < scalars.size(); i++ )
+    {
+        ASSERT_EQ( expectedScalars[i].first, scalars[i].first );
+        ASSERT_EQ( expectedScalars[i].second.index(), scalars[i].second.index() );
+    }
+
+    // Same arrays, with the same lengths except the z values, which depend on the faults.
+    ASSERT_EQ( expectedReader.getNamedArrayTypes(), reader.getNamedArrayTypes() );
+    for ( const auto& [name, kind] : reader.getNamedArrayTypes() )
+    {
+        if ( name != "zvalues.data" )
+        {
+            ASSERT_EQ( expectedReader.getArrayLength( name ), reader.getArrayLength( name ) ) << name;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, writeFiles )
+{
+    GridGeneratorOptions options;
+    options.nX = 3;
+    options.nY = 2;
+    options.nZ = 4;
+
+    for ( FileType fileType : { FileType::ROFF_BIN, FileType::ROFF_ASC } )
+    {
+        std::filesystem::path filePath =
+            std::filesystem::temp_directory_path() /
+            ( "roffcpp_generated_grid_" + std::to_string( std::random_device()() ) + ".roff" );
+        GridGenerator::write( filePath.string(), fileType, options );
+
+        ASSERT_EQ( fileType, FileTypeDetector::detect( filePath.string() ) );
+        {
+            Reader reader( filePath.string() );
+            reader.parse();
+            ASSERT_EQ( 24u, reader.getArrayLength( "FACIES" ) );
+        }
+        std::filesystem::remove( filePath );
+    }
+
+    ASSERT_THROW( GridGenerator::write( "unused.roff", FileType::UNKNOWN, options ), std::runtime_error );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( GridGeneratorTests, invalidOptions )
+{
+    std::stringstream stream;
+    BinaryWriter      writer( stream );
+
+    GridGeneratorOptions options;
+    options.nY = 0;
+    ASSERT_THROW( GridGenerator::write( writer, options ), std::runtime_error );
+
+    options          = GridGeneratorOptions();
+    options.numCodes = 0;
+    ASSERT_THROW( GridGenerator::write( writer, options ), std::runtime_error );
+}
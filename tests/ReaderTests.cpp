@@ -19,18 +19,44 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <variant>
 
+#include "AsciiWriter.hpp"
+#include "IndexFile.hpp"
 #include "Parser.hpp"
 #include "Reader.hpp"
 #include "RoffTestDataDirectory.hpp"
+#include "ThreadPool.hpp"
 #include "Token.hpp"
 #include "Tokenizer.hpp"
 
 using namespace roff;
 
+//--------------------------------------------------------------------------------------------------
+/// Copy of a test data file in the temp directory. The name is unique to the test and the process,
+/// so tests running in parallel do not share files.
+//--------------------------------------------------------------------------------------------------
+static std::filesystem::path copyToTempDirectory( const std::string& fileName )
+{
+    std::string testName = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::string tempName = "roffcpp_" + testName + "_" + std::to_string( std::random_device()() ) + "_" + fileName;
+
+    std::filesystem::path filePath = std::filesystem::temp_directory_path() / tempName;
+    std::filesystem::copy_file( std::string( TEST_DATA_DIR ) + "/" + fileName,
+                                filePath,
+                                std::filesystem::copy_options::overwrite_existing );
+    std::filesystem::remove( IndexFile::path( filePath.string() ) );
+    return filePath;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -280,13 +306,66 @@ TEST( ReaderTests, testParseGridFiles )
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-TEST( ReaderTests, testParseUnsupportedEndianness )
+TEST( ReaderTests, testParseAsciiIgnoresByteSwapTest )
 {
+    // Byte order does not apply to ascii files, so any byteswaptest value is accepted.
     std::ifstream stream( std::string( TEST_DATA_DIR ) + "/unsupported_endianness.roff", std::ios::binary );
     ASSERT_TRUE( stream.good() );
 
     Reader reader( stream );
-    ASSERT_THROW( reader.parse(), std::runtime_error );
+    reader.parse();
+
+    std::vector<std::pair<std::string, RoffScalar>> values = reader.scalarNamedValues();
+    ASSERT_FALSE( values.empty() );
+    ASSERT_EQ( "filedata.byteswaptest", values[0].first );
+    ASSERT_EQ( 0, std::get<int>( values[0].second ) );
+
+    Reader expectedReader( std::string( TEST_DATA_DIR ) + "/facies_info.roff" );
+    expectedReader.parse();
+    ASSERT_EQ( expectedReader.getNamedArrayTypes(), reader.getNamedArrayTypes() );
+    ASSERT_EQ( expectedReader.getIntArray( "composite" ), reader.getIntArray( "composite" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testParseBigEndianFiles )
+{
+    std::vector<std::pair<std::string, std::string>> fileNames = {
+        { "facies_info.roffbin", "facies_info_bigendian.roffbin" },
+        { "reek_box_grid_w_props.roff", "reek_box_grid_w_props_bigendian.roff" } };
+
+    for ( auto [littleEndianFileName, bigEndianFileName] : fileNames )
+    {
+        Reader expectedReader( std::string( TEST_DATA_DIR ) + "/" + littleEndianFileName );
+        expectedReader.parse();
+
+        Reader reader( std::string( TEST_DATA_DIR ) + "/" + bigEndianFileName );
+        reader.parse();
+
+        ASSERT_EQ( expectedReader.scalarNamedValues(), reader.scalarNamedValues() );
+        ASSERT_EQ( expectedReader.getNamedArrayTypes(), reader.getNamedArrayTypes() );
+
+        for ( auto [name, kind] : reader.getNamedArrayTypes() )
+        {
+            if ( kind == Token::Kind::INT )
+                ASSERT_EQ( expectedReader.getIntArray( name ), reader.getIntArray( name ) );
+            else if ( kind == Token::Kind::FLOAT )
+                ASSERT_EQ( expectedReader.getFloatArray( name ), reader.getFloatArray( name ) );
+            else if ( kind == Token::Kind::DOUBLE )
+                ASSERT_EQ( expectedReader.getDoubleArray( name ), reader.getDoubleArray( name ) );
+            else if ( kind == Token::Kind::CHAR )
+                ASSERT_EQ( expectedReader.getStringArray( name ), reader.getStringArray( name ) );
+            else
+                ASSERT_EQ( expectedReader.getByteArray( name ), reader.getByteArray( name ) );
+        }
+
+        // Views of swapped values are copies.
+        std::vector<float> expectedValues = expectedReader.getFloatArray( "zvalues.data" );
+        ArrayView<float>   view           = reader.getFloatArrayView( "zvalues.data" );
+        ASSERT_TRUE( expectedValues.empty() || view.isCopy() );
+        ASSERT_TRUE( std::equal( expectedValues.begin(), expectedValues.end(), view.begin() ) );
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -310,3 +389,670 @@ TEST( ReaderTests, testReadWrongFileType )
     }
     ASSERT_EQ( errMsg, std::string( "Unexpected file type." ) );
 }
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testParseMemoryMappedFiles )
+{
+    std::vector<std::string> fileNames = { "facies_info.roff",
+                                           "facies_info.roffbin",
+                                           "reek_box_grid_w_props.roff",
+                                           "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::string   filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+        std::ifstream stream( filePath, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+
+        Reader streamReader( stream );
+        streamReader.parse();
+
+        Reader mappedReader( filePath );
+        ASSERT_TRUE( mappedReader.isMemoryMapped() );
+        mappedReader.parse();
+
+        ASSERT_EQ( streamReader.scalarNamedValues(), mappedReader.scalarNamedValues() );
+        ASSERT_EQ( streamReader.getNamedArrayTypes(), mappedReader.getNamedArrayTypes() );
+
+        for ( auto [name, kind] : mappedReader.getNamedArrayTypes() )
+        {
+            if ( kind == Token::Kind::FLOAT )
+                ASSERT_EQ( streamReader.getFloatArray( name ), mappedReader.getFloatArray( name ) );
+            else if ( kind == Token::Kind::DOUBLE )
+                ASSERT_EQ( streamReader.getDoubleArray( name ), mappedReader.getDoubleArray( name ) );
+            else if ( kind == Token::Kind::INT )
+                ASSERT_EQ( streamReader.getIntArray( name ), mappedReader.getIntArray( name ) );
+            else if ( kind == Token::Kind::CHAR )
+                ASSERT_EQ( streamReader.getStringArray( name ), mappedReader.getStringArray( name ) );
+            else
+                ASSERT_EQ( streamReader.getByteArray( name ), mappedReader.getByteArray( name ) );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testOpenMissingFile )
+{
+    ASSERT_THROW( Reader( std::string( TEST_DATA_DIR ) + "/does_not_exist.roff" ), std::runtime_error );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testArrayViewsFromMemoryMappedFile )
+{
+    Reader reader( std::string( TEST_DATA_DIR ) + "/facies_info.roffbin" );
+    reader.parse();
+
+    // The float blob is 4-byte aligned in the file and can be viewed in place.
+    ArrayView<float>   floatView = reader.getFloatArrayView( "parameter.floatData" );
+    std::vector<float> floatData = reader.getFloatArray( "parameter.floatData" );
+    ASSERT_FALSE( floatView.isCopy() );
+    ASSERT_EQ( floatData, std::vector<float>( floatView.begin(), floatView.end() ) );
+
+    // The double blob is not 8-byte aligned in the file, so a copy is made.
+    ArrayView<double>   doubleView = reader.getDoubleArrayView( "parameter.doubleData" );
+    std::vector<double> doubleData = reader.getDoubleArray( "parameter.doubleData" );
+    ASSERT_TRUE( doubleView.isCopy() );
+    ASSERT_EQ( doubleData, std::vector<double>( doubleView.begin(), doubleView.end() ) );
+
+    ArrayView<int> intView = reader.getIntArrayView( "parameter.intData" );
+    ASSERT_EQ( 3u, intView.size() );
+    ASSERT_EQ( -1000, intView[0] );
+    ASSERT_EQ( 2, intView[2] );
+
+    ASSERT_TRUE( reader.getIntArrayView( "parameter.missing" ).empty() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Views of an array with another value type throw, also when the values would fit the view.
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testArrayViewsOfWrongType )
+{
+    for ( std::string fileName : { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" } )
+    {
+        Reader reader( std::string( TEST_DATA_DIR ) + "/" + fileName );
+        reader.parse();
+
+        // float array
+        ASSERT_THROW( reader.getIntArrayView( "zvalues.data" ), std::runtime_error );
+        ASSERT_THROW( reader.getDoubleArrayView( "zvalues.data" ), std::runtime_error );
+        ASSERT_THROW( reader.getByteArrayView( "zvalues.data" ), std::runtime_error );
+
+        // int array
+        ASSERT_THROW( reader.getFloatArrayView( "EQLNUM" ), std::runtime_error );
+        ASSERT_THROW( reader.getDoubleArrayView( "EQLNUM" ), std::runtime_error );
+        ASSERT_THROW( reader.getByteArrayView( "EQLNUM" ), std::runtime_error );
+
+        // byte and bool arrays
+        for ( std::string keyword : { "zvalues.splitEnz", "active.data" } )
+        {
+            ASSERT_THROW( reader.getIntArrayView( keyword ), std::runtime_error );
+            ASSERT_THROW( reader.getFloatArrayView( keyword ), std::runtime_error );
+            ASSERT_THROW( reader.getDoubleArrayView( keyword ), std::runtime_error );
+        }
+
+        ASSERT_NO_THROW( reader.getFloatArrayView( "zvalues.data" ) );
+        ASSERT_NO_THROW( reader.getIntArrayView( "EQLNUM" ) );
+        ASSERT_NO_THROW( reader.getByteArrayView( "active.data" ) );
+    }
+
+    // double array
+    Reader reader( std::string( TEST_DATA_DIR ) + "/facies_info.roffbin" );
+    reader.parse();
+    ASSERT_THROW( reader.getIntArrayView( "parameter.doubleData" ), std::runtime_error );
+    ASSERT_THROW( reader.getFloatArrayView( "parameter.doubleData" ), std::runtime_error );
+    ASSERT_THROW( reader.getByteArrayView( "parameter.doubleData" ), std::runtime_error );
+    ASSERT_THROW( reader.getDoubleArrayView( "parameter.intData" ), std::runtime_error );
+    ASSERT_NO_THROW( reader.getDoubleArrayView( "parameter.doubleData" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testArrayViewsFromAsciiFile )
+{
+    Reader reader( std::string( TEST_DATA_DIR ) + "/reek_box_grid_w_props.roffasc" );
+    reader.parse();
+
+    ArrayView<char> splitEnz = reader.getByteArrayView( "zvalues.splitEnz" );
+    ASSERT_TRUE( splitEnz.isCopy() );
+    ASSERT_EQ( 7920u, splitEnz.size() );
+    ASSERT_EQ( 4, splitEnz[0] );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testParseHeaderOnly )
+{
+    std::vector<std::string> fileNames = { "facies_info.roff",
+                                           "facies_info.roffbin",
+                                           "reek_box_grid_w_props.roff",
+                                           "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        Reader fullReader( filePath );
+        fullReader.parse();
+
+        std::ifstream stream( filePath, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+
+        Reader headerReader( stream );
+        headerReader.parse( ParseMode::HEADER_ONLY );
+
+        ASSERT_EQ( fullReader.scalarNamedValues(), headerReader.scalarNamedValues() );
+        ASSERT_EQ( fullReader.getNamedArrayTypes(), headerReader.getNamedArrayTypes() );
+
+        // Arrays are read on demand in the same way
+        for ( auto [name, kind] : headerReader.getNamedArrayTypes() )
+        {
+            ASSERT_EQ( fullReader.getArrayLength( name ), headerReader.getArrayLength( name ) );
+
+            if ( kind == Token::Kind::FLOAT )
+                ASSERT_EQ( fullReader.getFloatArray( name ), headerReader.getFloatArray( name ) );
+            else if ( kind == Token::Kind::DOUBLE )
+                ASSERT_EQ( fullReader.getDoubleArray( name ), headerReader.getDoubleArray( name ) );
+            else if ( kind == Token::Kind::INT )
+                ASSERT_EQ( fullReader.getIntArray( name ), headerReader.getIntArray( name ) );
+            else if ( kind == Token::Kind::CHAR )
+                ASSERT_EQ( fullReader.getStringArray( name ), headerReader.getStringArray( name ) );
+            else
+                ASSERT_EQ( fullReader.getByteArray( name ), headerReader.getByteArray( name ) );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testParseWithTagFilter )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        Reader fullReader( filePath );
+        fullReader.parse();
+
+        Reader filteredReader( filePath );
+        filteredReader.setTagFilter( { "dimensions", "zvalues", "PORO" } );
+        filteredReader.parse();
+
+        // filedata is always kept
+        std::vector<std::string> scalarNames;
+        for ( const auto& [name, value] : filteredReader.scalarNamedValues() )
+            scalarNames.push_back( name );
+
+        std::vector<std::string> expectedScalarNames = { "filedata.byteswaptest",
+                                                         "filedata.filetype",
+                                                         "filedata.creationDate",
+                                                         "dimensions.nX",
+                                                         "dimensions.nY",
+                                                         "dimensions.nZ",
+                                                         "parameter.name" };
+        ASSERT_EQ( expectedScalarNames, scalarNames );
+
+        std::vector<std::pair<std::string, Token::Kind>> expectedArrayTypes = {
+            { "zvalues.splitEnz", Token::Kind::BYTE },
+            { "zvalues.data", Token::Kind::FLOAT },
+            { "PORO", Token::Kind::FLOAT } };
+        ASSERT_EQ( expectedArrayTypes, filteredReader.getNamedArrayTypes() );
+
+        ASSERT_EQ( fullReader.getFloatArray( "zvalues.data" ), filteredReader.getFloatArray( "zvalues.data" ) );
+        ASSERT_EQ( fullReader.getFloatArray( "PORO" ), filteredReader.getFloatArray( "PORO" ) );
+
+        // Predicate
+        Reader predicateReader( filePath );
+        predicateReader.setTagFilter( []( const std::string& name ) { return name == "EQLNUM"; } );
+        predicateReader.parse( ParseMode::HEADER_ONLY );
+
+        ASSERT_EQ( 3u, predicateReader.getNamedArrayTypes().size() ); // data, codeNames and codeValues
+        ASSERT_EQ( fullReader.getIntArray( "EQLNUM" ), predicateReader.getIntArray( "EQLNUM" ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testReadArraysIntoBuffers )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::ifstream stream( std::string( TEST_DATA_DIR ) + "/" + fileName, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+
+        Reader reader( stream );
+        reader.parse();
+
+        std::vector<float> expected = reader.getFloatArray( "zvalues.data" );
+        ASSERT_FALSE( expected.empty() );
+
+        std::vector<float> values( expected.size() + 10, -1.0f );
+        ASSERT_EQ( expected.size(), reader.readFloatArray( "zvalues.data", values.data(), values.size() ) );
+        ASSERT_TRUE( std::equal( expected.begin(), expected.end(), values.begin() ) );
+        ASSERT_EQ( -1.0f, values.back() );
+
+        // Range
+        std::vector<float> range( 100 );
+        reader.readFloatArray( "zvalues.data", 1000, range.data(), range.size() );
+        ASSERT_TRUE( std::equal( range.begin(), range.end(), expected.begin() + 1000 ) );
+
+        std::vector<char> splitEnz( reader.getArrayLength( "zvalues.splitEnz" ) );
+        reader.readByteArray( "zvalues.splitEnz", splitEnz.data(), splitEnz.size() );
+        ASSERT_EQ( reader.getByteArray( "zvalues.splitEnz" ), splitEnz );
+
+        std::vector<int> eqlnum( reader.getArrayLength( "EQLNUM" ) );
+        reader.readIntArray( "EQLNUM", 0, eqlnum.data(), eqlnum.size() );
+        ASSERT_EQ( reader.getIntArray( "EQLNUM" ), eqlnum );
+
+        ASSERT_THROW( reader.readFloatArray( "zvalues.data", values.data(), expected.size() - 1 ), std::runtime_error );
+        ASSERT_THROW( reader.readFloatArray( "zvalues.data", expected.size() - 50, range.data(), range.size() ),
+                      std::runtime_error );
+        ASSERT_THROW( reader.readFloatArray( "does.not.exist", values.data(), values.size() ), std::runtime_error );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Reading parts of a large ASCII array only reads the bytes near each part, in any order.
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testReadAsciiArrayParts )
+{
+    // Counts the bytes read from the stream
+    class CountingBuffer : public std::stringbuf
+    {
+    public:
+        using std::stringbuf::stringbuf;
+        size_t numBytesRead = 0;
+
+    protected:
+        std::streamsize xsgetn( char* s, std::streamsize count ) override
+        {
+            std::streamsize numRead = std::stringbuf::xsgetn( s, count );
+            numBytesRead += static_cast<size_t>( numRead );
+            return numRead;
+        }
+    };
+
+    std::vector<float> values( 400000 );
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        values[i] = static_cast<float>( i ) * 0.37f - 1000.0f;
+    }
+
+    std::stringstream text;
+    AsciiWriter       writer( text );
+    writer.writeHeader();
+    writer.writeFileData( "grid", "01/02/2023 12:00:00" );
+    writer.beginTag( "arrays" );
+    writer.writeArray( "floats", values.data(), values.size() );
+    writer.endTag();
+    writer.finish();
+
+    CountingBuffer buffer( text.str() );
+    std::istream   stream( &buffer );
+    Reader         reader( stream );
+    reader.parse();
+
+    // In order
+    constexpr size_t   partSize = 40000;
+    std::vector<float> part( partSize );
+    buffer.numBytesRead = 0;
+    for ( size_t offset = 0; offset < values.size(); offset += partSize )
+    {
+        reader.readFloatArray( "arrays.floats", offset, part.data(), part.size() );
+        ASSERT_TRUE( std::equal( part.begin(), part.end(), values.begin() + offset ) );
+    }
+    ASSERT_LT( buffer.numBytesRead, 3 * text.str().size() );
+
+    // Backwards, and not at the ends of earlier parts
+    for ( size_t offset : { 359877, 250000, 123457, 40001, 7 } )
+    {
+        reader.readFloatArray( "arrays.floats", offset, part.data(), part.size() );
+        ASSERT_TRUE( std::equal( part.begin(), part.end(), values.begin() + offset ) );
+    }
+
+    std::vector<float> lastValue( 1 );
+    reader.readFloatArray( "arrays.floats", values.size() - 1, lastValue.data(), lastValue.size() );
+    ASSERT_EQ( values.back(), lastValue[0] );
+    ASSERT_EQ( values, reader.getFloatArray( "arrays.floats" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testConcurrentArrayReads )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        // Memory mapped, and a stream shared by all threads
+        std::ifstream stream( filePath, std::ios::binary );
+        Reader        mappedReader( filePath );
+        Reader        streamReader( stream );
+        mappedReader.parse();
+        streamReader.parse();
+
+        for ( const Reader* reader : { &mappedReader, &streamReader } )
+        {
+            std::vector<float> expectedPoro    = reader->getFloatArray( "PORO" );
+            std::vector<float> expectedZValues = reader->getFloatArray( "zvalues.data" );
+            std::vector<int>   expectedEqlnum  = reader->getIntArray( "EQLNUM" );
+            std::vector<char>  expectedActive  = reader->getByteArray( "active.data" );
+
+            std::atomic<int>         numErrors( 0 );
+            std::vector<std::thread> threads;
+            for ( int i = 0; i < 8; i++ )
+            {
+                threads.emplace_back(
+                    [&, i]()
+                    {
+                        for ( int j = 0; j < 10; j++ )
+                        {
+                            bool isEqual = false;
+                            if ( i % 4 == 0 )
+                                isEqual = reader->getFloatArray( "PORO" ) == expectedPoro;
+                            else if ( i % 4 == 1 )
+                                isEqual = reader->getFloatArray( "zvalues.data" ) == expectedZValues;
+                            else if ( i % 4 == 2 )
+                                isEqual = reader->getIntArray( "EQLNUM" ) == expectedEqlnum;
+                            else
+                                isEqual = reader->getByteArray( "active.data" ) == expectedActive;
+
+                            if ( !isEqual ) numErrors++;
+                        }
+                    } );
+            }
+
+            for ( auto& thread : threads )
+                thread.join();
+
+            ASSERT_EQ( 0, numErrors );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Large ASCII arrays are decoded on the pool of the reader, not on the global pool.
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testAsciiArraysDecodedOnReaderThreadPool )
+{
+    std::vector<float> values( 200000 );
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        values[i] = static_cast<float>( i ) * 0.37f - 1000.0f;
+    }
+
+    std::stringstream stream;
+    AsciiWriter       writer( stream );
+    writer.writeHeader();
+    writer.writeFileData( "grid", "01/02/2023 12:00:00" );
+    writer.beginTag( "arrays" );
+    writer.writeArray( "floats", values.data(), values.size() );
+    writer.endTag();
+    writer.finish();
+
+    Reader reader( stream );
+    reader.parse();
+
+    ThreadPool& globalPool = ThreadPool::globalInstance();
+    for ( size_t numThreads : { 1, 2 } )
+    {
+        ThreadPool pool( numThreads );
+        reader.setThreadPool( pool );
+
+        size_t numGlobalTasks = globalPool.numSubmittedTasks();
+        ASSERT_EQ( values, reader.getFloatArray( "arrays.floats" ) );
+        ASSERT_EQ( values, std::get<std::vector<float>>( reader.getArrays( { "arrays.floats" } )["arrays.floats"] ) );
+
+        std::vector<float> window( 150000 );
+        reader.readFloatArray( "arrays.floats", 10000, window.data(), window.size() );
+        ASSERT_TRUE( std::equal( window.begin(), window.end(), values.begin() + 10000 ) );
+
+        ASSERT_EQ( numGlobalTasks, globalPool.numSubmittedTasks() );
+        ASSERT_EQ( numThreads > 1, pool.numSubmittedTasks() > 0 );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testGetArrays )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff",
+                                           "reek_box_grid_w_props.roffasc",
+                                           "reek_box_grid_w_props_bigendian.roff" };
+
+    std::vector<std::string> keywords = { "zvalues.data",
+                                          "cornerLines.data",
+                                          "active.data",
+                                          "zvalues.splitEnz",
+                                          "EQLNUM.codeNames",
+                                          "EQLNUM" };
+
+    ThreadPool pool( 3 );
+    for ( auto fileName : fileNames )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        std::ifstream stream( filePath, std::ios::binary );
+        Reader        mappedReader( filePath );
+        Reader        streamReader( stream );
+        mappedReader.parse();
+        streamReader.parse();
+        streamReader.setThreadPool( pool );
+
+        for ( const Reader* reader : { &mappedReader, &streamReader } )
+        {
+            std::map<std::string, RoffArray> arrays = reader->getArrays( keywords );
+            ASSERT_EQ( keywords.size(), arrays.size() );
+
+            ASSERT_EQ( reader->getFloatArray( "zvalues.data" ),
+                       std::get<std::vector<float>>( arrays["zvalues.data"] ) );
+            ASSERT_EQ( reader->getFloatArray( "cornerLines.data" ),
+                       std::get<std::vector<float>>( arrays["cornerLines.data"] ) );
+            ASSERT_EQ( reader->getByteArray( "active.data" ), std::get<std::vector<char>>( arrays["active.data"] ) );
+            ASSERT_EQ( reader->getByteArray( "zvalues.splitEnz" ),
+                       std::get<std::vector<char>>( arrays["zvalues.splitEnz"] ) );
+            ASSERT_EQ( reader->getStringArray( "EQLNUM.codeNames" ),
+                       std::get<std::vector<std::string>>( arrays["EQLNUM.codeNames"] ) );
+            ASSERT_EQ( reader->getIntArray( "EQLNUM" ), std::get<std::vector<int>>( arrays["EQLNUM"] ) );
+
+            ASSERT_THROW( reader->getArrays( { "zvalues.data", "does.not.exist" } ), std::runtime_error );
+        }
+
+        // Called from a task of the pool of the reader, with no other thread to decode on
+        ThreadPool singleThreadPool( 1 );
+        streamReader.setThreadPool( singleThreadPool );
+
+        std::map<std::string, RoffArray> arrays;
+        singleThreadPool.submit( [&]() { arrays = streamReader.getArrays( keywords ); } ).get();
+        ASSERT_EQ( keywords.size(), arrays.size() );
+        ASSERT_EQ( streamReader.getFloatArray( "zvalues.data" ),
+                   std::get<std::vector<float>>( arrays["zvalues.data"] ) );
+        ASSERT_EQ( streamReader.getIntArray( "EQLNUM" ), std::get<std::vector<int>>( arrays["EQLNUM"] ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testIndexFile )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::filesystem::path filePath = copyToTempDirectory( fileName );
+
+        Reader expectedReader( filePath.string() );
+        expectedReader.parse();
+        ASSERT_FALSE( std::filesystem::exists( IndexFile::path( filePath.string() ) ) );
+
+        // First parse writes the index
+        {
+            Reader reader( filePath.string() );
+            reader.setUseIndexFile( true );
+            reader.parse();
+            ASSERT_TRUE( std::filesystem::exists( IndexFile::path( filePath.string() ) ) );
+        }
+
+        // Break the file header without changing the size or time stamp: only the index can be used.
+        auto modifiedTime = std::filesystem::last_write_time( filePath );
+        {
+            std::fstream stream( filePath, std::ios::binary | std::ios::in | std::ios::out );
+            stream.write( "xxxx", 4 );
+        }
+        std::filesystem::last_write_time( filePath, modifiedTime );
+
+        Reader reader( filePath.string() );
+        reader.setUseIndexFile( true );
+        reader.parse();
+
+        ASSERT_EQ( expectedReader.scalarNamedValues(), reader.scalarNamedValues() );
+        ASSERT_EQ( expectedReader.getNamedArrayTypes(), reader.getNamedArrayTypes() );
+        ASSERT_EQ( expectedReader.getScalar<int>( "dimensions.nX" ), reader.getScalar<int>( "dimensions.nX" ) );
+        ASSERT_EQ( expectedReader.arrayInfo( "zvalues.data" ).offset, reader.arrayInfo( "zvalues.data" ).offset );
+        ASSERT_EQ( expectedReader.getFloatArray( "zvalues.data" ), reader.getFloatArray( "zvalues.data" ) );
+        ASSERT_EQ( expectedReader.getByteArray( "active.data" ), reader.getByteArray( "active.data" ) );
+        ASSERT_EQ( expectedReader.getIntArray( "EQLNUM" ), reader.getIntArray( "EQLNUM" ) );
+        ASSERT_EQ( expectedReader.getStringArray( "EQLNUM.codeNames" ), reader.getStringArray( "EQLNUM.codeNames" ) );
+
+        // A changed file invalidates the index
+        std::filesystem::last_write_time( filePath, modifiedTime + std::chrono::seconds( 10 ) );
+        Reader changedReader( filePath.string() );
+        changedReader.setUseIndexFile( true );
+        ASSERT_THROW( changedReader.parse(), std::runtime_error );
+
+        std::filesystem::remove( filePath );
+        std::filesystem::remove( IndexFile::path( filePath.string() ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testIndexFileParseMode )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::filesystem::path filePath = copyToTempDirectory( fileName );
+
+        Reader expectedReader( filePath.string() );
+        expectedReader.parse();
+
+        {
+            Reader reader( filePath.string() );
+            reader.setUseIndexFile( true );
+            reader.parse( ParseMode::HEADER_ONLY );
+            ASSERT_TRUE( std::filesystem::exists( IndexFile::path( filePath.string() ) ) );
+        }
+
+        // Break the file header without changing the size or time stamp: only the index can be used.
+        auto modifiedTime = std::filesystem::last_write_time( filePath );
+        {
+            std::fstream stream( filePath, std::ios::binary | std::ios::in | std::ios::out );
+            stream.write( "xxxx", 4 );
+        }
+        std::filesystem::last_write_time( filePath, modifiedTime );
+
+        // The index written by the header only parse is used by header only parses only.
+        Reader headerReader( filePath.string() );
+        headerReader.setUseIndexFile( true );
+        headerReader.parse( ParseMode::HEADER_ONLY );
+        ASSERT_EQ( expectedReader.getFloatArray( "zvalues.data" ), headerReader.getFloatArray( "zvalues.data" ) );
+
+        Reader fullReader( filePath.string() );
+        fullReader.setUseIndexFile( true );
+        ASSERT_THROW( fullReader.parse( ParseMode::FULL ), std::runtime_error );
+
+        std::filesystem::remove( filePath );
+        std::filesystem::remove( IndexFile::path( filePath.string() ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testScalarAndArrayLookup )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        Reader reader( std::string( TEST_DATA_DIR ) + "/" + fileName );
+        reader.parse();
+
+        ASSERT_TRUE( reader.hasScalar( "dimensions.nX" ) );
+        ASSERT_EQ( 21, reader.getScalar<int>( "dimensions.nX" ) );
+        ASSERT_EQ( 23, reader.getScalar<int>( "dimensions.nY" ) );
+        ASSERT_EQ( 14, reader.getScalar<int>( "dimensions.nZ" ) );
+        ASSERT_EQ( 21, std::get<int>( reader.getScalar( "dimensions.nX" ) ) );
+
+        ASSERT_FALSE( reader.hasScalar( "dimensions.nW" ) );
+        ASSERT_THROW( reader.getScalar<int>( "dimensions.nW" ), std::runtime_error );
+        ASSERT_THROW( reader.getScalar<float>( "dimensions.nX" ), std::runtime_error );
+
+        // Parameter names occur several times: the first one is used
+        auto firstName = std::find_if( reader.scalarNamedValues().begin(),
+                                       reader.scalarNamedValues().end(),
+                                       []( const auto& arg ) { return arg.first == "parameter.name"; } );
+        ASSERT_NE( firstName, reader.scalarNamedValues().end() );
+        ASSERT_EQ( std::get<std::string>( firstName->second ), reader.getScalar<std::string>( "parameter.name" ) );
+
+        ASSERT_TRUE( reader.hasArray( "zvalues.data" ) );
+        const ArrayInfo& info = reader.arrayInfo( "zvalues.data" );
+        ASSERT_EQ( Token::Kind::FLOAT, info.kind );
+        ASSERT_EQ( reader.getArrayLength( "zvalues.data" ), info.length );
+        ASSERT_GT( info.offset, 0u );
+
+        ASSERT_EQ( Token::Kind::BYTE, reader.arrayInfo( "zvalues.splitEnz" ).kind );
+        ASSERT_EQ( Token::Kind::INT, reader.arrayInfo( "EQLNUM" ).kind );
+
+        ASSERT_FALSE( reader.hasArray( "does.not.exist" ) );
+        ASSERT_THROW( reader.arrayInfo( "does.not.exist" ), std::runtime_error );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ReaderTests, testTypedArrays )
+{
+    std::vector<std::string> fileNames = { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc" };
+
+    for ( auto fileName : fileNames )
+    {
+        Reader reader( std::string( TEST_DATA_DIR ) + "/" + fileName );
+        reader.parse();
+
+        ASSERT_EQ( reader.getFloatArray( "zvalues.data" ), reader.getArray<float>( "zvalues.data" ) );
+        ASSERT_EQ( reader.getFloatArray( "cornerLines.data" ), reader.getArray<float>( "cornerLines.data" ) );
+        ASSERT_EQ( reader.getByteArray( "zvalues.splitEnz" ), reader.getArray<char>( "zvalues.splitEnz" ) );
+        ASSERT_EQ( reader.getByteArray( "active.data" ), reader.getArray<char>( "active.data" ) );
+        ASSERT_EQ( reader.getIntArray( "EQLNUM" ), reader.getArray<int>( "EQLNUM" ) );
+        ASSERT_EQ( reader.getStringArray( "EQLNUM.codeNames" ), reader.getArray<std::string>( "EQLNUM.codeNames" ) );
+
+        ASSERT_THROW( reader.getArray<int>( "zvalues.data" ), std::runtime_error );
+        ASSERT_THROW( reader.getArray<double>( "zvalues.data" ), std::runtime_error );
+        ASSERT_THROW( reader.getArray<float>( "EQLNUM" ), std::runtime_error );
+        ASSERT_THROW( reader.getArray<std::string>( "zvalues.splitEnz" ), std::runtime_error );
+        ASSERT_THROW( reader.getArray<float>( "does.not.exist" ), std::runtime_error );
+    }
+}
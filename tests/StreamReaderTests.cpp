@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "EventHandler.hpp"
+#include "Reader.hpp"
+#include "RoffTestDataDirectory.hpp"
+#include "StreamReader.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+//==================================================================================================
+/// Collects the events, and the array values of one type.
+//==================================================================================================
+class CollectingHandler : public EventHandler
+{
+public:
+    void onTagBegin( const std::string& tagName ) override
+    {
+        m_tagName = tagName;
+        m_events.push_back( "tag " + tagName );
+    }
+
+    void onScalar( const std::string& name, const RoffScalar& value ) override
+    {
+        m_scalars.push_back( std::make_pair( m_tagName + "." + name, value ) );
+    }
+
+    void onArrayBegin( const std::string& name, Token::Kind kind, size_t length ) override
+    {
+        m_events.push_back( "array " + name + " " + std::to_string( length ) );
+        m_arrayTypes.push_back( std::make_pair( name, kind ) );
+        m_arrays.emplace_back();
+    }
+
+    void onArrayChunk( const std::string& /*name*/, const ArrayChunk& values, size_t offset ) override
+    {
+        size_t chunkSize = std::visit( []( const auto& view ) { return view.size(); }, values );
+        m_maxChunkSize   = std::max( m_maxChunkSize, chunkSize );
+
+        // Keep all values as strings to compare arrays of any type
+        std::vector<std::string>& array = m_arrays.back();
+        EXPECT_EQ( array.size(), offset );
+        std::visit(
+            [&array]( const auto& view )
+            {
+                for ( const auto& value : view )
+                    array.push_back( toString( value ) );
+            },
+            values );
+    }
+
+    void onTagEnd( const std::string& tagName ) override { m_events.push_back( "endtag " + tagName ); }
+
+    template <typename T>
+    static std::string toString( const T& value )
+    {
+        std::ostringstream stream;
+        stream << +value;
+        return stream.str();
+    }
+
+    static std::string toString( const std::string& value ) { return value; }
+
+    std::string                                      m_tagName;
+    std::vector<std::string>                         m_events;
+    std::vector<std::pair<std::string, RoffScalar>>  m_scalars;
+    std::vector<std::pair<std::string, Token::Kind>> m_arrayTypes;
+    std::vector<std::vector<std::string>>            m_arrays;
+    size_t                                           m_maxChunkSize = 0;
+};
+
+//==================================================================================================
+/// Stream buffer that can not seek and returns a few bytes at a time, like a pipe.
+//==================================================================================================
+class PipeStreamBuffer : public std::streambuf
+{
+public:
+    explicit PipeStreamBuffer( std::string data )
+        : m_data( std::move( data ) )
+        , m_pos( 0 )
+    {
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if ( m_pos == m_data.size() ) return traits_type::eof();
+
+        size_t size = std::min( m_data.size() - m_pos, size_t( 7 ) );
+        setg( m_data.data() + m_pos, m_data.data() + m_pos, m_data.data() + m_pos + size );
+        m_pos += size;
+        return traits_type::to_int_type( *gptr() );
+    }
+
+private:
+    std::string m_data;
+    size_t      m_pos;
+};
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+std::vector<std::string> toStrings( const std::vector<T>& values )
+{
+    std::vector<std::string> strings;
+    for ( const auto& value : values )
+        strings.push_back( CollectingHandler::toString( value ) );
+    return strings;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( StreamReaderTests, testEvents )
+{
+    std::stringstream stream( "roff-asc tag dimensions int nX 2 endtag "
+                              "tag parameter char name \"P\" array float data 3 1.5 #c# 2 3 endtag" );
+
+    CollectingHandler handler;
+    StreamReader      reader( stream );
+    reader.read( handler );
+
+    std::vector<std::string> expectedEvents =
+        { "tag dimensions", "endtag dimensions", "tag parameter", "array data 3", "endtag parameter" };
+    ASSERT_EQ( expectedEvents, handler.m_events );
+
+    ASSERT_EQ( 2u, handler.m_scalars.size() );
+    ASSERT_EQ( "dimensions.nX", handler.m_scalars[0].first );
+    ASSERT_EQ( 2, std::get<int>( handler.m_scalars[0].second ) );
+    ASSERT_EQ( "P", std::get<std::string>( handler.m_scalars[1].second ) );
+
+    ASSERT_EQ( std::vector<std::string>( { "1.5", "2", "3" } ), handler.m_arrays[0] );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Small chunks, so that arrays are split in many chunks.
+//--------------------------------------------------------------------------------------------------
+TEST( StreamReaderTests, testSameContentAsReader )
+{
+    std::vector<std::string> fileNames = { "facies_info.roff",
+                                           "facies_info.roffbin",
+                                           "reek_box_grid_w_props.roff",
+                                           "reek_box_grid_w_props.roffasc",
+                                           "facies_info_bigendian.roffbin",
+                                           "reek_box_grid_w_props_bigendian.roff" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        Reader reader( filePath );
+        reader.parse();
+
+        std::ifstream stream( filePath, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+
+        CollectingHandler handler;
+        StreamReader      streamReader( stream );
+        streamReader.setChunkSize( 1000 );
+        streamReader.read( handler );
+
+        ASSERT_EQ( reader.scalarNamedValues(), handler.m_scalars );
+        ASSERT_LE( handler.m_maxChunkSize, 1000u );
+
+        // Same arrays in the same order (the Reader renames parameter arrays)
+        std::vector<std::pair<std::string, Token::Kind>> arrayTypes = reader.getNamedArrayTypes();
+        ASSERT_EQ( arrayTypes.size(), handler.m_arrayTypes.size() );
+        for ( size_t i = 0; i < arrayTypes.size(); i++ )
+        {
+            auto [name, kind] = arrayTypes[i];
+            ASSERT_EQ( kind, handler.m_arrayTypes[i].second );
+
+            std::vector<std::string> expected;
+            if ( kind == Token::Kind::FLOAT )
+                expected = toStrings( reader.getFloatArray( name ) );
+            else if ( kind == Token::Kind::DOUBLE )
+                expected = toStrings( reader.getDoubleArray( name ) );
+            else if ( kind == Token::Kind::INT )
+                expected = toStrings( reader.getIntArray( name ) );
+            else if ( kind == Token::Kind::CHAR )
+                expected = reader.getStringArray( name );
+            else
+                expected = toStrings( reader.getByteArray( name ) );
+
+            ASSERT_EQ( expected, handler.m_arrays[i] );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( StreamReaderTests, testAsciiIgnoresByteSwapTest )
+{
+    std::ifstream stream( std::string( TEST_DATA_DIR ) + "/unsupported_endianness.roff", std::ios::binary );
+    ASSERT_TRUE( stream.good() );
+
+    CollectingHandler handler;
+    StreamReader      reader( stream );
+    reader.read( handler );
+
+    ASSERT_FALSE( handler.m_scalars.empty() );
+    ASSERT_EQ( RoffScalar( 0 ), handler.m_scalars[0].second );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( StreamReaderTests, testNonSeekableStream )
+{
+    for ( auto fileName : { "reek_box_grid_w_props.roff", "reek_box_grid_w_props.roffasc", "facies_info.roffbin" } )
+    {
+        std::string filePath = std::string( TEST_DATA_DIR ) + "/" + fileName;
+
+        std::ifstream stream( filePath, std::ios::binary );
+        ASSERT_TRUE( stream.good() );
+        std::ostringstream content;
+        content << stream.rdbuf();
+        stream.seekg( 0 );
+
+        CollectingHandler expectedHandler;
+        StreamReader      expectedReader( stream );
+        expectedReader.setChunkSize( 1000 );
+        expectedReader.read( expectedHandler );
+
+        PipeStreamBuffer  pipeBuffer( content.str() );
+        std::istream      pipe( &pipeBuffer );
+        CollectingHandler handler;
+        StreamReader      reader( pipe );
+        reader.setChunkSize( 1000 );
+        reader.read( handler );
+
+        ASSERT_EQ( expectedHandler.m_events, handler.m_events );
+        ASSERT_EQ( expectedHandler.m_scalars, handler.m_scalars );
+        ASSERT_EQ( expectedHandler.m_arrays, handler.m_arrays );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Seekable streams are left directly after the file, although more was read ahead.
+//--------------------------------------------------------------------------------------------------
+TEST( StreamReaderTests, testStreamPositionAfterRead )
+{
+    std::string       file = "roff-asc tag dimensions int nX 2 endtag tag eof endtag";
+    std::stringstream stream( file + " trailing" );
+
+    CollectingHandler handler;
+    StreamReader      reader( stream );
+    reader.read( handler );
+
+    std::string rest;
+    std::getline( stream, rest );
+    ASSERT_EQ( "trailing", rest );
+}
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ThreadPoolTests, submit )
+{
+    ThreadPool pool( 2 );
+    ASSERT_EQ( 2u, pool.size() );
+    ASSERT_EQ( 0u, pool.numSubmittedTasks() );
+
+    std::atomic<int> value( 0 );
+    pool.submit( [&value]() { value = 42; } ).get();
+    ASSERT_EQ( 42, value );
+    ASSERT_EQ( 1u, pool.numSubmittedTasks() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ThreadPoolTests, parallelFor )
+{
+    ThreadPool pool( 4 );
+
+    std::vector<int> values( 1000, 0 );
+    pool.parallelFor( values.size(), [&values]( size_t i ) { values[i] = static_cast<int>( i ); } );
+
+    for ( size_t i = 0; i < values.size(); i++ )
+        ASSERT_EQ( static_cast<int>( i ), values[i] );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Tasks waiting for nested work must not dead-lock the pool.
+//--------------------------------------------------------------------------------------------------
+TEST( ThreadPoolTests, nestedParallelFor )
+{
+    ThreadPool pool( 2 );
+
+    std::atomic<int> sum( 0 );
+    pool.parallelFor( 8, [&pool, &sum]( size_t ) { pool.parallelFor( 8, [&sum]( size_t ) { sum++; } ); } );
+    ASSERT_EQ( 64, sum );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( ThreadPoolTests, parallelForRethrows )
+{
+    ThreadPool pool( 2 );
+
+    ASSERT_THROW( pool.parallelFor( 16,
+                                    []( size_t i )
+                                    {
+                                        if ( i == 7 ) throw std::runtime_error( "failed" );
+                                    } ),
+                  std::runtime_error );
+}
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Token.hpp"
+#include "TokenStore.hpp"
+
+using namespace roff;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( TokenStoreTests, SameTokensAsStored )
+{
+    std::vector<Token> tokens = { Token( Token::Kind::TAG, 3u, 6u ),
+                                  Token( Token::Kind::STRING_LITERAL, 7u, 7u ),
+                                  Token( Token::Kind::ARRAYBLOB, 100u, 4000u ) };
+
+    TokenStore store;
+    ASSERT_TRUE( store.empty() );
+    for ( const Token& token : tokens )
+    {
+        store.push_back( token );
+    }
+
+    ASSERT_EQ( tokens.size(), store.size() );
+    for ( size_t i = 0; i < tokens.size(); i++ )
+    {
+        ASSERT_EQ( tokens[i].kind(), store[i].kind() );
+        ASSERT_EQ( tokens[i].start(), store[i].start() );
+        ASSERT_EQ( tokens[i].end(), store[i].end() );
+        ASSERT_EQ( tokens[i].kind(), store.kind( i ) );
+        ASSERT_EQ( tokens[i].start(), store.start( i ) );
+        ASSERT_EQ( tokens[i].end(), store.end( i ) );
+    }
+
+    store.clear();
+    ASSERT_TRUE( store.empty() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( TokenStoreTests, LargeOffsets )
+{
+    if constexpr ( sizeof( size_t ) < sizeof( uint64_t ) ) GTEST_SKIP();
+
+    size_t start = static_cast<size_t>( ( uint64_t( 1 ) << 40 ) + 12345u );
+    size_t end   = start + static_cast<size_t>( ( uint64_t( 1 ) << 33 ) + 7u );
+
+    TokenStore store;
+    store.push_back( Token( Token::Kind::ARRAYBLOB, start, end ) );
+    ASSERT_EQ( start, store.start( 0 ) );
+    ASSERT_EQ( end, store.end( 0 ) );
+
+    size_t maxOffset = static_cast<size_t>( TokenStore::maxOffset() );
+    store.push_back( Token( Token::Kind::ARRAYBLOB, maxOffset, maxOffset ) );
+    ASSERT_EQ( maxOffset, store.start( 1 ) );
+
+    Token outOfRange( Token::Kind::ARRAYBLOB, maxOffset + 1, maxOffset + 1 );
+    ASSERT_THROW( store.push_back( outOfRange ), std::runtime_error );
+    ASSERT_EQ( 2u, store.size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( TokenStoreTests, SmallerThanTokens )
+{
+    TokenStore store;
+    store.reserve( 1000 );
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        store.push_back( Token( Token::Kind::STRING_LITERAL, i * 10, i * 10 + 5 ) );
+    }
+
+    ASSERT_EQ( 1u, sizeof( Token::Kind ) );
+    ASSERT_LT( store.memoryUsage(), 1000 * sizeof( Token ) );
+}
@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include <string>
+#include <vector>
 
 #include "Token.hpp"
 
@@ -37,3 +38,32 @@ TEST( TokenTests, SimpleTest )
     ASSERT_EQ( start, token.start() );
     ASSERT_EQ( end, token.end() );
 }
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( TokenTests, KeywordKind )
+{
+    std::vector<Token::Kind> keywords = { Token::Kind::ROFF_ASC,
+                                          Token::Kind::ROFF_BIN,
+                                          Token::Kind::TAG,
+                                          Token::Kind::ENDTAG,
+                                          Token::Kind::CHAR,
+                                          Token::Kind::BOOL,
+                                          Token::Kind::BYTE,
+                                          Token::Kind::INT,
+                                          Token::Kind::FLOAT,
+                                          Token::Kind::DOUBLE,
+                                          Token::Kind::ARRAY };
+
+    for ( Token::Kind kind : keywords )
+    {
+        ASSERT_EQ( kind, Token::keywordKind( Token::kindToString( kind ) ) );
+    }
+
+    ASSERT_FALSE( Token::keywordKind( "" ).has_value() );
+    ASSERT_FALSE( Token::keywordKind( "tags" ).has_value() );
+    ASSERT_FALSE( Token::keywordKind( "in" ).has_value() );
+    ASSERT_FALSE( Token::keywordKind( "roff-foo" ).has_value() );
+    ASSERT_FALSE( Token::keywordKind( "name" ).has_value() );
+}
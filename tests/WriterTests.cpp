@@ -0,0 +1,391 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "AsciiWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "Reader.hpp"
+#include "RoffTestDataDirectory.hpp"
+#include "StreamReader.hpp"
+#include "ThreadPool.hpp"
+#include "WriterEventHandler.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void compareReaders( const Reader& expectedReader, const Reader& reader )
+{
+    ASSERT_EQ( expectedReader.scalarNamedValues(), reader.scalarNamedValues() );
+    ASSERT_EQ( expectedReader.getNamedArrayTypes(), reader.getNamedArrayTypes() );
+
+    for ( auto [name, kind] : reader.getNamedArrayTypes() )
+    {
+        if ( kind == Token::Kind::INT )
+            ASSERT_EQ( expectedReader.getIntArray( name ), reader.getIntArray( name ) );
+        else if ( kind == Token::Kind::FLOAT )
+            ASSERT_EQ( expectedReader.getFloatArray( name ), reader.getFloatArray( name ) );
+        else if ( kind == Token::Kind::DOUBLE )
+            ASSERT_EQ( expectedReader.getDoubleArray( name ), reader.getDoubleArray( name ) );
+        else if ( kind == Token::Kind::CHAR )
+            ASSERT_EQ( expectedReader.getStringArray( name ), reader.getStringArray( name ) );
+        else
+            ASSERT_EQ( expectedReader.getByteArray( name ), reader.getByteArray( name ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Writes all kinds of scalars and arrays to the stream of the writer and reads them back.
+//--------------------------------------------------------------------------------------------------
+void checkWriteFile( Writer& writer, std::stringstream& stream )
+{
+    std::vector<float>       zvalues     = { 1.5f, -2.25f, 3.0f, 1.0e10f, -0.0f };
+    std::vector<char>        splitEnz    = { 1, 4, 1, 1, 2 };
+    std::vector<char>        active      = { 1, 0, 1 };
+    std::vector<int>         eqlnum      = { 1, 2, 2 };
+    std::vector<std::string> codeNames   = { "first", "" };
+    std::vector<int>         codeValues  = { 1, 2 };
+    std::vector<double>      coordinates = { 0.1, 1.0e-300, -5.5 };
+
+    writer.writeHeader();
+    writer.writeFileData( "grid", "01/02/2023 12:00:00" );
+
+    writer.beginTag( "dimensions" );
+    writer.writeScalar( "nX", 3 );
+    writer.writeScalar( "nY", 1 );
+    writer.writeScalar( "nZ", 1 );
+    writer.endTag();
+
+    writer.beginTag( "scalars" );
+    writer.writeScalar( "f", 1.5f );
+    writer.writeScalar( "d", -2.5 );
+    writer.writeScalar( "b", true );
+    writer.writeScalar( "c", static_cast<unsigned char>( 42 ) );
+    writer.writeScalar( "s", std::string( "text" ) );
+    writer.endTag();
+
+    writer.beginTag( "zvalues" );
+    writer.writeArray( "splitEnz", splitEnz.data(), splitEnz.size() );
+    writer.beginArray( "data", Token::Kind::FLOAT, zvalues.size() );
+    writer.appendArrayValues( zvalues.data(), 2 );
+    writer.appendArrayValues( zvalues.data() + 2, 3 );
+    writer.endArray();
+    writer.endTag();
+
+    writer.beginTag( "active" );
+    writer.writeArray( "data", active.data(), active.size(), Token::Kind::BOOL );
+    writer.endTag();
+
+    writer.beginTag( "coordinates" );
+    writer.writeArray( "data", coordinates.data(), coordinates.size() );
+    writer.writeArray( "empty", coordinates.data(), 0 );
+    writer.endTag();
+
+    writer.beginTag( "parameter" );
+    writer.writeScalar( "name", std::string( "EQLNUM" ) );
+    writer.writeArray( "codeNames", codeNames );
+    writer.writeArray( "codeValues", codeValues.data(), codeValues.size() );
+    writer.writeArray( "data", eqlnum.data(), eqlnum.size() );
+    writer.endTag();
+    writer.finish();
+
+    Reader reader( stream );
+    reader.parse();
+
+    ASSERT_EQ( 1, reader.getScalar<int>( "filedata.byteswaptest" ) );
+    ASSERT_EQ( "grid", reader.getScalar<std::string>( "filedata.filetype" ) );
+    ASSERT_EQ( 3, reader.getScalar<int>( "dimensions.nX" ) );
+    ASSERT_EQ( 1.5f, reader.getScalar<float>( "scalars.f" ) );
+    ASSERT_EQ( -2.5, reader.getScalar<double>( "scalars.d" ) );
+    ASSERT_EQ( true, reader.getScalar<bool>( "scalars.b" ) );
+    ASSERT_EQ( 42, reader.getScalar<unsigned char>( "scalars.c" ) );
+    ASSERT_EQ( "text", reader.getScalar<std::string>( "scalars.s" ) );
+
+    ASSERT_EQ( zvalues, reader.getArray<float>( "zvalues.data" ) );
+    ASSERT_EQ( splitEnz, reader.getArray<char>( "zvalues.splitEnz" ) );
+    ASSERT_EQ( Token::Kind::BOOL, reader.arrayInfo( "active.data" ).kind );
+    ASSERT_EQ( active, reader.getArray<char>( "active.data" ) );
+    ASSERT_EQ( coordinates, reader.getArray<double>( "coordinates.data" ) );
+    ASSERT_EQ( 0u, reader.getArrayLength( "coordinates.empty" ) );
+    ASSERT_EQ( eqlnum, reader.getArray<int>( "EQLNUM" ) );
+    ASSERT_EQ( codeNames, reader.getArray<std::string>( "EQLNUM.codeNames" ) );
+    ASSERT_EQ( codeValues, reader.getArray<int>( "EQLNUM.codeValues" ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Rewrites the test files with the given writer type and compares the results to the files.
+//--------------------------------------------------------------------------------------------------
+template <typename WriterType>
+void checkRewriteFiles()
+{
+    std::vector<std::string> fileNames = { "facies_info.roffbin",
+                                           "facies_info.roff",
+                                           "reek_box_grid_w_props.roff",
+                                           "reek_box_grid_w_props.roffasc",
+                                           "reek_box_grid_w_props_bigendian.roff" };
+
+    for ( auto fileName : fileNames )
+    {
+        std::ifstream inputStream( std::string( TEST_DATA_DIR ) + "/" + fileName, std::ios::binary );
+        ASSERT_TRUE( inputStream.good() );
+
+        std::stringstream  outputStream;
+        WriterType         writer( outputStream );
+        WriterEventHandler handler( writer );
+        StreamReader       streamReader( inputStream );
+        streamReader.setChunkSize( 1000 );
+        streamReader.read( handler );
+        ASSERT_TRUE( handler.isFinished() );
+
+        Reader expectedReader( std::string( TEST_DATA_DIR ) + "/" + fileName );
+        expectedReader.parse();
+
+        Reader reader( outputStream );
+        reader.parse();
+        compareReaders( expectedReader, reader );
+    }
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, writeBinaryFile )
+{
+    std::stringstream stream;
+    BinaryWriter      writer( stream );
+    checkWriteFile( writer, stream );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, writeAsciiFile )
+{
+    std::stringstream stream;
+    AsciiWriter       writer( stream );
+    checkWriteFile( writer, stream );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, rewriteBinaryFiles )
+{
+    checkRewriteFiles<BinaryWriter>();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, rewriteAsciiFiles )
+{
+    checkRewriteFiles<AsciiWriter>();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// A file written by RMS is rewritten with the same text, except for the creator comment.
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, asciiLayout )
+{
+    std::string   fileName = std::string( TEST_DATA_DIR ) + "/reek_box_grid_w_props.roffasc";
+    std::ifstream inputStream( fileName, std::ios::binary );
+    ASSERT_TRUE( inputStream.good() );
+
+    std::stringstream  outputStream;
+    AsciiWriter        writer( outputStream );
+    WriterEventHandler handler( writer );
+    StreamReader       streamReader( inputStream );
+    streamReader.setChunkSize( 1001 );
+    streamReader.read( handler );
+
+    std::ifstream expectedStream( fileName, std::ios::binary );
+    std::string   expectedLine;
+    std::string   line;
+    size_t        lineNumber = 0;
+    while ( std::getline( expectedStream, expectedLine ) )
+    {
+        ASSERT_TRUE( std::getline( outputStream, line ) );
+        if ( ++lineNumber == 3 )
+            ASSERT_EQ( "#Creator: roffcpp#", line );
+        else
+            ASSERT_EQ( expectedLine, line ) << "line " << lineNumber;
+    }
+
+    ASSERT_FALSE( std::getline( outputStream, line ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Scalars are written as RMS writes them, also when rounding exact ties.
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, asciiScalarLayout )
+{
+    std::stringstream stream;
+    AsciiWriter       writer( stream );
+    writer.writeHeader();
+    writer.beginTag( "scalars" );
+    writer.writeScalar( "n", 3 );
+    writer.writeScalar( "f", 1.5f );
+    writer.writeScalar( "tie", -456511.0625f );
+    writer.writeScalar( "small", 1.0e-40f );
+    writer.writeScalar( "d", -2.5 );
+    writer.writeScalar( "b", true );
+    writer.writeScalar( "c", static_cast<unsigned char>( 200 ) );
+    writer.writeScalar( "s", std::string( "text" ) );
+    writer.endTag();
+    writer.finish();
+
+    std::vector<std::string> expectedLines = { "roff-asc ",
+                                               "#ROFF file#",
+                                               "#Creator: roffcpp#",
+                                               "tag scalars ",
+                                               "int n 3           ",
+                                               "float f   1.50000000E+00",
+                                               "float tie  -4.56511063E+05",
+                                               "float small   9.99994610E-41",
+                                               "double d  -2.5000000000000000E+00",
+                                               "bool b 1",
+                                               "byte c 200",
+                                               "char s  \"text\"",
+                                               "endtag ",
+                                               "tag eof ",
+                                               "endtag " };
+
+    std::string line;
+    for ( const auto& expectedLine : expectedLines )
+    {
+        ASSERT_TRUE( std::getline( stream, line ) );
+        ASSERT_EQ( expectedLine, line );
+    }
+    ASSERT_FALSE( std::getline( stream, line ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Arrays larger than a formatting chunk are formatted in parallel, also when appended in pieces that
+/// end in the middle of a line.
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, writeLargeAsciiArrays )
+{
+    size_t              numValues = 100003;
+    std::vector<float>  floats( numValues );
+    std::vector<double> doubles( numValues );
+    std::vector<int>    ints( numValues );
+    std::vector<char>   bytes( numValues );
+    for ( size_t i = 0; i < numValues; i++ )
+    {
+        floats[i]  = static_cast<float>( i ) * 0.37f - 1000.0f;
+        doubles[i] = static_cast<double>( i ) / 3.0 - 1.0e6;
+        ints[i]    = static_cast<int>( i * 7919 ) - 500000;
+        bytes[i]   = static_cast<char>( i );
+    }
+
+    ThreadPool        pool( 3 );
+    std::stringstream stream;
+    AsciiWriter       writer( stream );
+    writer.setThreadPool( pool );
+    writer.writeHeader();
+    writer.writeFileData( "grid", "01/02/2023 12:00:00" );
+    writer.beginTag( "arrays" );
+    writer.writeArray( "floats", floats.data(), floats.size() );
+    writer.writeArray( "ints", ints.data(), ints.size() );
+    writer.writeArray( "bytes", bytes.data(), bytes.size() );
+
+    writer.beginArray( "doubles", Token::Kind::DOUBLE, numValues );
+    for ( size_t offset = 0; offset < numValues; offset += 30001 )
+    {
+        writer.appendArrayValues( doubles.data() + offset, std::min<size_t>( 30001, numValues - offset ) );
+    }
+    writer.endArray();
+    writer.endTag();
+    writer.finish();
+
+    // Full lines except for the last line of each array.
+    std::string text       = stream.str();
+    size_t      arrayBegin = text.find( "array float floats" );
+    ASSERT_NE( std::string::npos, arrayBegin );
+    size_t firstLineBegin = text.find( '\n', arrayBegin ) + 1;
+    ASSERT_EQ( 4u * 17u, text.find( '\n', firstLineBegin ) - firstLineBegin );
+
+    Reader reader( stream );
+    reader.parse();
+    ASSERT_EQ( floats, reader.getArray<float>( "arrays.floats" ) );
+    ASSERT_EQ( doubles, reader.getArray<double>( "arrays.doubles" ) );
+    ASSERT_EQ( ints, reader.getArray<int>( "arrays.ints" ) );
+    ASSERT_EQ( bytes, reader.getArray<char>( "arrays.bytes" ) );
+
+    // Large chunks of ASCII values are decoded in parallel when converting
+    std::stringstream  binaryStream;
+    BinaryWriter       binaryWriter( binaryStream );
+    WriterEventHandler handler( binaryWriter );
+    stream.clear();
+    stream.seekg( 0 );
+    StreamReader streamReader( stream );
+    streamReader.setThreadPool( pool );
+    streamReader.read( handler );
+    ASSERT_TRUE( handler.isFinished() );
+
+    Reader binaryReader( binaryStream );
+    binaryReader.parse();
+    compareReaders( reader, binaryReader );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+TEST( WriterTests, invalidStructure )
+{
+    std::vector<int> values = { 1, 2, 3 };
+
+    std::stringstream stream;
+    BinaryWriter      writer( stream );
+    ASSERT_THROW( writer.beginTag( "dimensions" ), std::runtime_error );
+
+    writer.writeHeader();
+    ASSERT_THROW( writer.writeHeader(), std::runtime_error );
+    ASSERT_THROW( writer.writeScalar( "nX", 1 ), std::runtime_error );
+    ASSERT_THROW( writer.endTag(), std::runtime_error );
+
+    writer.beginTag( "dimensions" );
+    ASSERT_THROW( writer.beginTag( "nested" ), std::runtime_error );
+    ASSERT_THROW( writer.beginArray( "data", Token::Kind::ARRAY, 1 ), std::runtime_error );
+
+    writer.beginArray( "data", Token::Kind::INT, values.size() );
+    ASSERT_THROW( writer.appendArrayValues( std::vector<float>( 1 ).data(), 1 ), std::runtime_error );
+    ASSERT_THROW( writer.writeScalar( "nX", 1 ), std::runtime_error );
+    ASSERT_THROW( writer.endTag(), std::runtime_error );
+    writer.appendArrayValues( values.data(), 2 );
+    ASSERT_THROW( writer.endArray(), std::runtime_error );
+    ASSERT_THROW( writer.appendArrayValues( values.data(), 2 ), std::runtime_error );
+    writer.appendArrayValues( values.data() + 2, 1 );
+    writer.endArray();
+
+    ASSERT_THROW( writer.finish(), std::runtime_error );
+    writer.endTag();
+    writer.finish();
+    ASSERT_THROW( writer.beginTag( "dimensions" ), std::runtime_error );
+}
@@ -0,0 +1,204 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "AsciiWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "FileTypeDetector.hpp"
+#include "StreamReader.hpp"
+#include "ThreadPool.hpp"
+#include "WriterEventHandler.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+struct Options
+{
+    std::string             inputFileName;
+    std::string             outputFileName;
+    std::optional<FileType> outputType;
+    size_t                  numThreads = 0;
+    size_t                  chunkSize  = 65536;
+};
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void printUsage()
+{
+    std::cerr << "Usage: roffconvert [options] <input> <output>\n"
+                 "\n"
+                 "Converts a ROFF file from ASCII to binary, or from binary to ASCII. The file is streamed, so\n"
+                 "memory use does not depend on the size of the file. The input can be a pipe. Use - to read\n"
+                 "from standard input or write to standard output.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --to-binary        Write a binary file (default for ASCII input)\n"
+                 "  --to-ascii         Write an ASCII file (default for binary input)\n"
+                 "  --threads <n>      Threads for decoding and formatting numbers (default: all)\n"
+                 "  --chunk-size <n>   Array values held in memory at a time (default: 65536)\n";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t parseCount( const std::string& text )
+{
+    size_t length = 0;
+    size_t count  = std::stoul( text, &length );
+    if ( length != text.size() ) throw std::invalid_argument( text );
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Options parseArguments( const std::vector<std::string>& arguments )
+{
+    Options                  options;
+    std::vector<std::string> fileNames;
+    for ( size_t i = 0; i < arguments.size(); i++ )
+    {
+        const std::string& argument = arguments[i];
+        if ( argument == "--to-binary" )
+        {
+            options.outputType = FileType::ROFF_BIN;
+        }
+        else if ( argument == "--to-ascii" )
+        {
+            options.outputType = FileType::ROFF_ASC;
+        }
+        else if ( ( argument == "--threads" || argument == "--chunk-size" ) && i + 1 < arguments.size() )
+        {
+            size_t count = parseCount( arguments[++i] );
+            if ( argument == "--threads" )
+                options.numThreads = count;
+            else
+                options.chunkSize = count;
+        }
+        else if ( argument.rfind( "--", 0 ) == 0 )
+        {
+            throw std::invalid_argument( argument );
+        }
+        else
+        {
+            fileNames.push_back( argument );
+        }
+    }
+
+    if ( fileNames.size() != 2 ) throw std::invalid_argument( "Expected an input and an output file." );
+
+    options.inputFileName  = fileNames[0];
+    options.outputFileName = fileNames[1];
+    return options;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void convert( const Options& options )
+{
+    std::ifstream inputFile;
+    if ( options.inputFileName != "-" )
+    {
+        inputFile.open( options.inputFileName, std::ios::binary );
+        if ( !inputFile ) throw std::runtime_error( "Failed to open " + options.inputFileName );
+    }
+    std::istream& inputStream = options.inputFileName == "-" ? std::cin : inputFile;
+
+    FileType inputType = FileTypeDetector::detect( inputStream );
+    if ( inputType == FileType::UNKNOWN ) throw std::runtime_error( "Not a ROFF file: " + options.inputFileName );
+
+    FileType outputType =
+        options.outputType.value_or( inputType == FileType::ROFF_ASC ? FileType::ROFF_BIN : FileType::ROFF_ASC );
+
+    // Large output buffer, set before the file is opened.
+    std::vector<char> outputBuffer( 1024 * 1024 );
+    std::ofstream     outputFile;
+    if ( options.outputFileName != "-" )
+    {
+        outputFile.rdbuf()->pubsetbuf( outputBuffer.data(), static_cast<std::streamsize>( outputBuffer.size() ) );
+        outputFile.open( options.outputFileName, std::ios::binary );
+        if ( !outputFile ) throw std::runtime_error( "Failed to open " + options.outputFileName );
+    }
+    std::ostream& outputStream = options.outputFileName == "-" ? std::cout : outputFile;
+
+    ThreadPool pool( options.numThreads );
+
+    std::unique_ptr<Writer> writer;
+    if ( outputType == FileType::ROFF_ASC )
+    {
+        auto asciiWriter = std::make_unique<AsciiWriter>( outputStream );
+        asciiWriter->setThreadPool( pool );
+        writer = std::move( asciiWriter );
+    }
+    else
+    {
+        writer = std::make_unique<BinaryWriter>( outputStream );
+    }
+
+    WriterEventHandler handler( *writer );
+    StreamReader       reader( inputStream );
+    reader.setChunkSize( options.chunkSize );
+    reader.setThreadPool( pool );
+    reader.read( handler );
+
+    if ( !handler.isFinished() ) throw std::runtime_error( "Missing eof tag in " + options.inputFileName );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    // Buffered standard streams, which also lets the file type be detected on a piped input.
+    std::ios::sync_with_stdio( false );
+
+    Options options;
+    try
+    {
+        options = parseArguments( std::vector<std::string>( argv + 1, argv + argc ) );
+    }
+    catch ( const std::exception& e )
+    {
+        std::cerr << "roffconvert: invalid arguments: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    try
+    {
+        convert( options );
+    }
+    catch ( const std::exception& e )
+    {
+        std::cerr << "roffconvert: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
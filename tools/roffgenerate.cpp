@@ -0,0 +1,194 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2023-     Equinor ASA
+//
+//  roffcpp is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  roffcpp is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.
+//
+//  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+//  for more details.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "AsciiWriter.hpp"
+#include "BinaryWriter.hpp"
+#include "GridGenerator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace roff;
+
+namespace
+{
+struct Options
+{
+    std::string          outputFileName;
+    FileType             outputType = FileType::ROFF_BIN;
+    GridGeneratorOptions grid;
+};
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void printUsage()
+{
+    std::cerr << "Usage: roffgenerate [options] <nX> <nY> <nZ> <output>\n"
+                 "\n"
+                 "Writes a synthetic ROFF grid file of the given dimensions, with corner lines, z values, active\n"
+                 "cells and parameters. The same options always give the same file.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --ascii                  Write an ASCII file (default: binary)\n"
+                 "  --float-parameters <n>   Float parameters FLOAT_1 .. FLOAT_n (default: 1)\n"
+                 "  --int-parameters <n>     Int parameters INT_1 .. INT_n (default: 1)\n"
+                 "  --codes <n>              Codes of the int parameters (default: 2)\n"
+                 "  --seed <n>               Seed of the generated values (default: 0)\n";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+unsigned long long parseCount( const std::string& text )
+{
+    size_t             length = 0;
+    unsigned long long count  = std::stoull( text, &length );
+    if ( length != text.size() || text[0] == '-' ) throw std::invalid_argument( text );
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int parseDimension( const std::string& text )
+{
+    unsigned long long dimension = parseCount( text );
+    if ( dimension < 1 || dimension > 1000000 ) throw std::invalid_argument( text );
+    return static_cast<int>( dimension );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<std::string> parameterNames( const std::string& prefix, unsigned long long count )
+{
+    std::vector<std::string> names;
+    for ( unsigned long long i = 1; i <= count; i++ )
+    {
+        names.push_back( prefix + std::to_string( i ) );
+    }
+
+    return names;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+Options parseArguments( const std::vector<std::string>& arguments )
+{
+    Options                  options;
+    std::vector<std::string> positionals;
+    options.grid.floatParameters = parameterNames( "FLOAT_", 1 );
+    options.grid.intParameters   = parameterNames( "INT_", 1 );
+    for ( size_t i = 0; i < arguments.size(); i++ )
+    {
+        const std::string& argument = arguments[i];
+        if ( argument == "--ascii" )
+        {
+            options.outputType = FileType::ROFF_ASC;
+        }
+        else if ( ( argument == "--float-parameters" || argument == "--int-parameters" || argument == "--codes" ||
+                    argument == "--seed" ) &&
+                  i + 1 < arguments.size() )
+        {
+            unsigned long long count = parseCount( arguments[++i] );
+            if ( argument == "--float-parameters" )
+                options.grid.floatParameters = parameterNames( "FLOAT_", count );
+            else if ( argument == "--int-parameters" )
+                options.grid.intParameters = parameterNames( "INT_", count );
+            else if ( argument == "--codes" )
+                options.grid.numCodes = static_cast<int>( std::min( count, 1000000ull ) );
+            else
+                options.grid.seed = count;
+        }
+        else if ( argument.rfind( "--", 0 ) == 0 )
+        {
+            throw std::invalid_argument( argument );
+        }
+        else
+        {
+            positionals.push_back( argument );
+        }
+    }
+
+    if ( positionals.size() != 4 ) throw std::invalid_argument( "Expected three dimensions and an output file." );
+
+    options.grid.nX        = parseDimension( positionals[0] );
+    options.grid.nY        = parseDimension( positionals[1] );
+    options.grid.nZ        = parseDimension( positionals[2] );
+    options.outputFileName = positionals[3];
+    return options;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void generate( const Options& options )
+{
+    // Large output buffer, set before the file is opened.
+    std::vector<char> outputBuffer( 1024 * 1024 );
+    std::ofstream     outputStream;
+    outputStream.rdbuf()->pubsetbuf( outputBuffer.data(), static_cast<std::streamsize>( outputBuffer.size() ) );
+    outputStream.open( options.outputFileName, std::ios::binary );
+    if ( !outputStream ) throw std::runtime_error( "Failed to open " + options.outputFileName );
+
+    std::unique_ptr<Writer> writer;
+    if ( options.outputType == FileType::ROFF_ASC )
+        writer = std::make_unique<AsciiWriter>( outputStream );
+    else
+        writer = std::make_unique<BinaryWriter>( outputStream );
+
+    GridGenerator::write( *writer, options.grid );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    Options options;
+    try
+    {
+        options = parseArguments( std::vector<std::string>( argv + 1, argv + argc ) );
+    }
+    catch ( const std::exception& e )
+    {
+        std::cerr << "roffgenerate: invalid arguments: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    try
+    {
+        generate( options );
+    }
+    catch ( const std::exception& e )
+    {
+        std::cerr << "roffgenerate: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}